@@ -0,0 +1,102 @@
+#include "BuscadorAproximado.h"
+#include <algorithm>
+using namespace std;
+
+BuscadorAproximado::BuscadorAproximado(const string &patron, int imaxErrores) : maxErrores(imaxErrores) {
+    for (int c = 0; c < 4; c++) {
+        coincidencias[c] = 0;
+    }
+    for (char base : patron) {
+        int cod = SecuenciaEmpaquetada::codificar(base);
+        if (cod < 0) {
+            codigos.clear();
+            return;
+        }
+        codigos.push_back(cod);
+    }
+    if (codigos.size() <= MAX_MYERS) {
+        for (size_t j = 0; j < codigos.size(); j++) {
+            coincidencias[codigos[j]] |= 1ULL << j;
+        }
+    }
+}
+
+bool BuscadorAproximado::esValido() const {
+    return !codigos.empty() && maxErrores >= 0;
+}
+
+size_t BuscadorAproximado::longitud() const {
+    return codigos.size();
+}
+
+void BuscadorAproximado::buscar(const VistaEmpaquetada &v, int idSecuencia, vector<CoincidenciaAproximada> &resultado) const {
+    if (!esValido()) {
+        return;
+    }
+    if (codigos.size() <= MAX_MYERS) {
+        buscarMyers(v, idSecuencia, resultado);
+    } else {
+        buscarTabla(v, idSecuencia, resultado);
+    }
+}
+
+// Pv/Mv: bit j a 1 si D[j+1][i] - D[j][i] es +1 / -1 en la columna actual.
+// La fila 0 vale siempre 0 (la aparición puede empezar en cualquier parte),
+// así que las diferencias horizontales no arrastran un 1 por abajo.
+// 'distancia' sigue el valor de la última fila, D[m][i].
+void BuscadorAproximado::buscarMyers(const VistaEmpaquetada &v, int idSecuencia, vector<CoincidenciaAproximada> &resultado) const {
+    const size_t m = codigos.size();
+    const uint64_t ultima = 1ULL << (m - 1);
+    uint64_t pv = (m == 64) ? ~0ULL : ((1ULL << m) - 1);
+    uint64_t mv = 0;
+    int distancia = m;
+
+    for (size_t i = 0; i < v.longitud(); i++) {
+        uint64_t eq = coincidencias[v.codigo(i)];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & ultima) {
+            distancia++;
+        } else if (mh & ultima) {
+            distancia--;
+        }
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (distancia <= maxErrores) {
+            CoincidenciaAproximada c;
+            c.secuencia = idSecuencia;
+            c.fin = i;
+            c.distancia = distancia;
+            resultado.push_back(c);
+        }
+    }
+}
+
+// Programación dinámica clásica con una sola columna
+void BuscadorAproximado::buscarTabla(const VistaEmpaquetada &v, int idSecuencia, vector<CoincidenciaAproximada> &resultado) const {
+    const size_t m = codigos.size();
+    vector<int> columna(m + 1);
+    for (size_t j = 0; j <= m; j++) {
+        columna[j] = j;
+    }
+    for (size_t i = 0; i < v.longitud(); i++) {
+        int cod = v.codigo(i);
+        int diagonal = 0; // D[j-1][i-1]; la fila 0 vale siempre 0
+        for (size_t j = 1; j <= m; j++) {
+            int arriba = columna[j];
+            columna[j] = min(min(columna[j] + 1, columna[j - 1] + 1), diagonal + (codigos[j - 1] != cod));
+            diagonal = arriba;
+        }
+        if (columna[m] <= maxErrores) {
+            CoincidenciaAproximada c;
+            c.secuencia = idSecuencia;
+            c.fin = i;
+            c.distancia = columna[m];
+            resultado.push_back(c);
+        }
+    }
+}
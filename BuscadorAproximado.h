@@ -0,0 +1,53 @@
+#ifndef BUSCADORAPROXIMADO_H
+#define BUSCADORAPROXIMADO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Aparición aproximada de un patrón: registro de la lista, posición de la
+// última base de la aparición y distancia de edición (sustituciones,
+// inserciones y borrados) entre el patrón y el texto que termina ahí
+struct CoincidenciaAproximada {
+    int secuencia;
+    int fin;
+    int distancia;
+};
+
+// Búsqueda con errores de un patrón sobre secuencias empaquetadas: se
+// informa de cada posición del texto en la que termina una aparición con
+// distancia de edición <= maxErrores (varias posiciones seguidas pueden
+// corresponder a la misma aparición).
+//  - Patrones de hasta 64 bases: algoritmo de Myers (en la forma de Hyyrö),
+//    que guarda una columna de la tabla de distancias como dos palabras de
+//    diferencias verticales; cada base del texto cuesta unas pocas
+//    operaciones de palabra.
+//  - Patrones más largos: la misma tabla calculada columna a columna.
+// Se compila una vez; las búsquedas son de solo lectura y pueden hacerse
+// desde varios hilos a la vez.
+class BuscadorAproximado {
+    private:
+    vector<int> codigos;   // Patrón codificado (vacío si no es válido)
+    int maxErrores;
+    uint64_t coincidencias[4]; // Myers: bit j a 1 si patron[j] == base
+
+    void buscarMyers(const VistaEmpaquetada &, int, vector<CoincidenciaAproximada> &) const;
+    void buscarTabla(const VistaEmpaquetada &, int, vector<CoincidenciaAproximada> &) const;
+    public:
+    static const size_t MAX_MYERS = 64;
+
+    BuscadorAproximado(const string &, int maxErrores);
+
+    // Un patrón vacío o no válido, o un máximo negativo, no aparece nunca
+    bool esValido() const;
+    size_t longitud() const;
+
+    // Añade a 'resultado' las apariciones, etiquetadas con 'idSecuencia',
+    // en orden de posición
+    void buscar(const VistaEmpaquetada &, int idSecuencia, vector<CoincidenciaAproximada> &resultado) const;
+};
+
+#endif // BUSCADORAPROXIMADO_H
@@ -0,0 +1,113 @@
+#include "BuscadorMultiple.h"
+using namespace std;
+
+// =============================================
+// CONSTRUCCIÓN DEL AUTÓMATA
+// =============================================
+
+// Los patrones vacíos o con caracteres distintos de A, C, G, T se conservan
+// (para no alterar los índices) pero no aparecen nunca
+BuscadorMultiple::BuscadorMultiple(const vector<string> &ipatrones) : patrones(ipatrones) {
+    // Trie: -1 marca una transición todavía inexistente
+    transiciones.assign(4, -1);
+    vector<vector<int>> terminan(1);
+
+    for (size_t p = 0; p < patrones.size(); p++) {
+        const string &patron = patrones[p];
+        bool valido = !patron.empty();
+        for (char c : patron) {
+            if (SecuenciaEmpaquetada::codificar(c) < 0) {
+                valido = false;
+            }
+        }
+        if (!valido) {
+            continue;
+        }
+
+        int estado = 0;
+        for (char c : patron) {
+            int cod = SecuenciaEmpaquetada::codificar(c);
+            if (transiciones[4 * estado + cod] < 0) {
+                transiciones[4 * estado + cod] = terminan.size();
+                transiciones.insert(transiciones.end(), 4, -1);
+                terminan.emplace_back();
+            }
+            estado = transiciones[4 * estado + cod];
+        }
+        terminan[estado].push_back(p);
+    }
+
+    // Recorrido en anchura: enlaces de fallo y cierre de transiciones
+    size_t estados = terminan.size();
+    vector<int> fallo(estados, 0);
+    enlaceSalida.assign(estados, -1);
+    vector<int> cola;
+    for (int c = 0; c < 4; c++) {
+        int hijo = transiciones[c];
+        if (hijo < 0) {
+            transiciones[c] = 0;
+        } else {
+            cola.push_back(hijo);
+        }
+    }
+    for (size_t k = 0; k < cola.size(); k++) {
+        int estado = cola[k];
+        int f = fallo[estado];
+        enlaceSalida[estado] = terminan[f].empty() ? enlaceSalida[f] : f;
+        for (int c = 0; c < 4; c++) {
+            int hijo = transiciones[4 * estado + c];
+            if (hijo < 0) {
+                transiciones[4 * estado + c] = transiciones[4 * f + c];
+            } else {
+                fallo[hijo] = transiciones[4 * f + c];
+                cola.push_back(hijo);
+            }
+        }
+    }
+
+    // Salidas en formato compacto
+    inicioSalida.assign(estados + 1, 0);
+    for (size_t e = 0; e < estados; e++) {
+        inicioSalida[e + 1] = inicioSalida[e] + terminan[e].size();
+        patronesSalida.insert(patronesSalida.end(), terminan[e].begin(), terminan[e].end());
+    }
+}
+
+size_t BuscadorMultiple::numPatrones() const {
+    return patrones.size();
+}
+
+const string &BuscadorMultiple::getPatron(int p) const {
+    return patrones[p];
+}
+
+// =============================================
+// BÚSQUEDA
+// =============================================
+
+void BuscadorMultiple::buscar(const VistaEmpaquetada &v, int idSecuencia,
+                              vector<CoincidenciaPatron> &resultado) const {
+    int estado = 0;
+    size_t i = 0;
+    size_t n = v.longitud();
+
+    for (size_t w = 0; w < v.numPalabras(); w++) {
+        uint64_t palabra = v.palabras[w];
+        size_t limite = (n - i < 32) ? n - i : 32;
+        for (size_t k = 0; k < limite; k++, i++, palabra >>= 2) {
+            estado = transiciones[4 * estado + (palabra & 3)];
+
+            // Patrones que terminan aquí y en los sufijos con salida
+            for (int e = estado; e >= 0; e = enlaceSalida[e]) {
+                for (int s = inicioSalida[e]; s < inicioSalida[e + 1]; s++) {
+                    int p = patronesSalida[s];
+                    CoincidenciaPatron c;
+                    c.secuencia = idSecuencia;
+                    c.patron = p;
+                    c.posicion = (int)(i + 1 - patrones[p].length());
+                    resultado.push_back(c);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef BUSCADORMULTIPLE_H
+#define BUSCADORMULTIPLE_H
+
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Aparición de un patrón: registro de la lista, índice del patrón y
+// posición de inicio dentro de la secuencia
+struct CoincidenciaPatron {
+    int secuencia;
+    int patron;
+    int posicion;
+};
+
+// Autómata de Aho-Corasick sobre el alfabeto A, C, G, T para buscar muchos
+// patrones (cebadores, dianas de restricción...) en una sola pasada.
+// Se compila una vez; las búsquedas son de solo lectura y pueden hacerse
+// desde varios hilos a la vez.
+class BuscadorMultiple {
+    private:
+    vector<string> patrones;
+    vector<int> transiciones;     // 4 por estado, autómata completo (sin fallos)
+    vector<int> enlaceSalida;     // Estado más cercano por sufijo con patrones, o -1
+    vector<int> inicioSalida;     // Patrones que terminan en cada estado (CSR)
+    vector<int> patronesSalida;
+    public:
+    BuscadorMultiple(const vector<string> &);
+
+    size_t numPatrones() const;
+    const string &getPatron(int) const;
+
+    // Añade a 'resultado' todas las apariciones en la secuencia, etiquetadas
+    // con 'idSecuencia', en orden de posición final
+    void buscar(const VistaEmpaquetada &, int idSecuencia, vector<CoincidenciaPatron> &resultado) const;
+};
+
+#endif // BUSCADORMULTIPLE_H
@@ -0,0 +1,154 @@
+#include "BuscadorPatron.h"
+using namespace std;
+
+// =============================================
+// PREPARACIÓN DEL PATRÓN
+// =============================================
+
+BuscadorPatron::BuscadorPatron(const string &patron) {
+    for (char c : patron) {
+        int cod = SecuenciaEmpaquetada::codificar(c);
+        if (cod < 0) {
+            codigos.clear();
+            break;
+        }
+        codigos.push_back(cod);
+    }
+
+    size_t m = codigos.size();
+    for (int c = 0; c < 4; c++) {
+        mascaras[c] = mascarasInv[c] = ~0ULL;
+        saltos[c] = saltosInv[c] = m;
+    }
+    if (m == 0) {
+        return;
+    }
+
+    if (m <= MAX_SHIFT_OR) {
+        for (size_t j = 0; j < m; j++) {
+            mascaras[codigos[j]] &= ~(1ULL << j);
+            mascarasInv[codigos[m - 1 - j]] &= ~(1ULL << j);
+        }
+    } else {
+        // Salto según la base alineada con el final (o el principio) de la ventana
+        for (size_t j = 0; j + 1 < m; j++) {
+            saltos[codigos[j]] = m - 1 - j;
+        }
+        for (size_t j = m - 1; j > 0; j--) {
+            saltosInv[codigos[j]] = j;
+        }
+    }
+}
+
+bool BuscadorPatron::esValido() const {
+    return !codigos.empty();
+}
+
+size_t BuscadorPatron::longitud() const {
+    return codigos.size();
+}
+
+// Compara la ventana que empieza en pos de derecha a izquierda
+bool BuscadorPatron::coincideEn(const VistaEmpaquetada &v, size_t pos) const {
+    size_t j = codigos.size();
+    while (j > 0 && v.codigo(pos + j - 1) == codigos[j - 1]) {
+        j--;
+    }
+    return j == 0;
+}
+
+// =============================================
+// RECORRIDO HACIA DELANTE
+// =============================================
+
+// Llama a f(posicion) por cada aparición, de izquierda a derecha,
+// hasta terminar o hasta que f devuelva false
+template <typename F>
+void BuscadorPatron::recorrer(const VistaEmpaquetada &v, F f) const {
+    size_t m = codigos.size();
+    size_t n = v.longitud();
+    if (m == 0 || m > n) {
+        return;
+    }
+
+    if (m <= MAX_SHIFT_OR) {
+        const uint64_t fin = 1ULL << (m - 1);
+        uint64_t estado = ~0ULL;
+        size_t i = 0;
+        // Se decodifica palabra a palabra: 32 bases por lectura de memoria
+        for (size_t w = 0; w < v.numPalabras(); w++) {
+            uint64_t palabra = v.palabras[w];
+            size_t limite = (n - i < 32) ? n - i : 32;
+            for (size_t k = 0; k < limite; k++, i++, palabra >>= 2) {
+                estado = (estado << 1) | mascaras[palabra & 3];
+                if ((estado & fin) == 0 && !f((int)(i + 1 - m))) {
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    size_t pos = 0;
+    while (pos + m <= n) {
+        if (coincideEn(v, pos) && !f((int)pos)) {
+            return;
+        }
+        pos += saltos[v.codigo(pos + m - 1)];
+    }
+}
+
+// =============================================
+// CONSULTAS
+// =============================================
+
+int BuscadorPatron::primera(const VistaEmpaquetada &v) const {
+    int posicion = -1;
+    recorrer(v, [&](int p) { posicion = p; return false; });
+    return posicion;
+}
+
+// Recorre el texto de derecha a izquierda: la primera coincidencia es la última
+int BuscadorPatron::ultima(const VistaEmpaquetada &v) const {
+    size_t m = codigos.size();
+    size_t n = v.longitud();
+    if (m == 0 || m > n) {
+        return -1;
+    }
+
+    if (m <= MAX_SHIFT_OR) {
+        const uint64_t fin = 1ULL << (m - 1);
+        uint64_t estado = ~0ULL;
+        for (size_t i = n; i > 0; i--) {
+            estado = (estado << 1) | mascarasInv[v.codigo(i - 1)];
+            if ((estado & fin) == 0) {
+                return i - 1;
+            }
+        }
+        return -1;
+    }
+
+    size_t pos = n - m;
+    while (true) {
+        if (coincideEn(v, pos)) {
+            return pos;
+        }
+        size_t salto = saltosInv[v.codigo(pos)];
+        if (salto > pos) {
+            return -1;
+        }
+        pos -= salto;
+    }
+}
+
+vector<int> BuscadorPatron::todas(const VistaEmpaquetada &v) const {
+    vector<int> posiciones;
+    recorrer(v, [&](int p) { posiciones.push_back(p); return true; });
+    return posiciones;
+}
+
+int BuscadorPatron::contar(const VistaEmpaquetada &v) const {
+    int total = 0;
+    recorrer(v, [&](int) { total++; return true; });
+    return total;
+}
@@ -0,0 +1,41 @@
+#ifndef BUSCADORPATRON_H
+#define BUSCADORPATRON_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Búsqueda exacta de un patrón sobre una secuencia empaquetada sin crear
+// subcadenas. Se compila una vez y se puede reutilizar con varias secuencias.
+//  - Patrones de hasta 64 bases: Shift-Or (bitap), una palabra por estado.
+//  - Patrones más largos: Horspool con tabla de saltos sobre A, C, G, T.
+// La última aparición se busca recorriendo el texto de derecha a izquierda.
+class BuscadorPatron {
+    private:
+    vector<int> codigos;        // Patrón codificado (vacío si no es válido)
+    uint64_t mascaras[4];       // Shift-Or: bit j a 0 si patron[j] == base
+    uint64_t mascarasInv[4];    // Igual, sobre el patrón invertido
+    size_t saltos[4];           // Horspool hacia delante
+    size_t saltosInv[4];        // Horspool hacia atrás
+
+    bool coincideEn(const VistaEmpaquetada &, size_t) const;
+    template <typename F> void recorrer(const VistaEmpaquetada &, F) const;
+    public:
+    static const size_t MAX_SHIFT_OR = 64;
+
+    BuscadorPatron(const string &);
+
+    // Un patrón vacío o con caracteres distintos de A, C, G, T no aparece nunca
+    bool esValido() const;
+    size_t longitud() const;
+
+    int primera(const VistaEmpaquetada &) const;  // -1 si no aparece
+    int ultima(const VistaEmpaquetada &) const;   // -1 si no aparece
+    vector<int> todas(const VistaEmpaquetada &) const;
+    int contar(const VistaEmpaquetada &) const;
+};
+
+#endif // BUSCADORPATRON_H
@@ -1,15 +1,34 @@
 #include "CadenaADN.h"
+#include "BuscadorPatron.h"
+#include "IndiceFM.h"
+#include <algorithm>
+#include <utility>
 using namespace std;
 
 
 vector<string> CadenaADN::obtenerCodones() const {
     vector<string> v;
-    for (size_t i = 0; i + 2 < secuencia.length(); i += 3) {
-        v.push_back(secuencia.substr(i, 3));
+    for (int codon : codones()) {
+        v.push_back(SecuenciaEmpaquetada::decodificarCodon(codon));
     }
     return v;
 }
 
+// Codones en marco como enteros 0..63, sin crear cadenas
+VistaCodones CadenaADN::codones() const {
+    return VistaCodones(secuencia.vista());
+}
+
+// Frecuencia de cada codón en marco, indexada por su código de 6 bits
+array<int, 64> CadenaADN::histogramaCodones() const {
+    array<int, 64> histograma;
+    histograma.fill(0);
+    for (int codon : codones()) {
+        histograma[codon]++;
+    }
+    return histograma;
+}
+
 
 // =============================================
 // FUNCIONES AUXILIARES
@@ -30,11 +49,9 @@ bool CadenaADN::validador(const string &isec, const string &idesc) const {
     // NOTA: Esta línea estaba comentada - no requiere que empiece con ATG
     // if (isec.substr(0, 3) != "ATG") { return false; }
     
-    // Todos los caracteres deben ser A, T, C o G
-    for (char c : isec) {
-        if (c != 'A' && c != 'T' && c != 'C' && c != 'G') { 
-            return false;
-        }
+    // Todos los caracteres deben ser A, T, C o G (comprobación vectorial)
+    if (SecuenciaEmpaquetada::primeraNoValida(isec.data(), isec.length()) >= 0) {
+        return false;
     }
 
     // La descripción no puede contener saltos de línea
@@ -46,16 +63,62 @@ bool CadenaADN::validador(const string &isec, const string &idesc) const {
 }
 
 // Cuenta cuántas veces aparece una subcadena en la secuencia
+// Trabaja sobre la secuencia empaquetada sin crear subcadenas, o sobre el
+// índice FM si se ha construido
 int CadenaADN::contador(const string &serie) const {
-    int contador = 0;
-    int longitud_serie = serie.length();
+    VistaEmpaquetada v = secuencia.vista();
+    size_t longitud_serie = serie.length();
 
-    for (int i = 0; i < secuencia.length(); i++) {
-        if (secuencia.substr(i, longitud_serie) == serie) { 
-            contador++; 
-        }
+    if (longitud_serie == 0) {
+        return v.longitud();
     }
-    return contador;
+
+    // Una sola base: comparación de 32 bases por palabra
+    if (longitud_serie == 1) {
+        int codigo = SecuenciaEmpaquetada::codificar(serie[0]);
+        return (codigo < 0) ? 0 : v.contarBase(codigo);
+    }
+
+    if (indice) {
+        return indice->contar(serie);
+    }
+    return BuscadorPatron(serie).contar(v);
+}
+
+// Descarta las estadísticas en caché (la secuencia ha cambiado por completo)
+void CadenaADN::invalidarEstadisticas() {
+    estadisticas.cuentasValidas = false;
+    estadisticas.rachasValidas = false;
+    estadisticas.homopolimerosValidos = false;
+}
+
+// Calcula en una sola pasada la racha más larga de cada base
+void CadenaADN::calcularRachas() const {
+    secuencia.vista().rachasMaximas(estadisticas.rachaMaxima);
+    estadisticas.rachasValidas = true;
+}
+
+// Longitud de la racha de la base 'codigo' que pasa por la posición pos
+// (supone que la base en pos es 'codigo')
+int CadenaADN::longitudRacha(size_t pos, int codigo) const {
+    size_t ini = pos, fin = pos + 1;
+    while (ini > 0 && secuencia.codigo(ini - 1) == codigo) {
+        ini--;
+    }
+    while (fin < secuencia.longitud() && secuencia.codigo(fin) == codigo) {
+        fin++;
+    }
+    return fin - ini;
+}
+
+string CadenaADN::traducir(int marco) const {
+    return CodigoGenetico::traducir(secuencia.vista(), marco);
+}
+
+vector<MarcoAbierto> CadenaADN::buscarORFs(int minAminoacidos) const {
+    vector<MarcoAbierto> resultado;
+    CodigoGenetico::buscarORFs(secuencia.vista(), max(minAminoacidos, 0), 0, resultado);
+    return resultado;
 }
 
 // =============================================
@@ -64,30 +127,63 @@ int CadenaADN::contador(const string &serie) const {
 
 // Constructor por defecto - crea secuencia "ATG" vacía
 CadenaADN::CadenaADN() {
-    secuencia = "ATG"; 
+    secuencia.asignar("ATG"); 
     descripcion = "";
 }
 
 // Constructor con parámetros - valida antes de asignar
 CadenaADN::CadenaADN(const string &isec, const string &idesc) {
-    secuencia = "ATG";
+    secuencia.asignar("ATG");
     descripcion = "";
     
     if (validador(isec, idesc)) {
-        secuencia = isec; 
+        secuencia.asignar(isec); 
+        descripcion = idesc;
+    }
+}
+
+// Constructor desde una vista empaquetada (por ejemplo, un registro de lista)
+CadenaADN::CadenaADN(const VistaEmpaquetada &v, const string &idesc) {
+    secuencia.asignar("ATG");
+    descripcion = "";
+
+    if (v.longitud() >= 3 && v.longitud() % 3 == 0 && validador("ATG", idesc)) {
+        secuencia = SecuenciaEmpaquetada(v);
+        descripcion = idesc;
+    }
+}
+
+// Constructor desde una secuencia ya empaquetada, que se adopta sin copiarla
+// ni revisar sus bases (solo pueden ser A, C, G o T)
+CadenaADN::CadenaADN(SecuenciaEmpaquetada &&isec, const string &idesc) {
+    secuencia.asignar("ATG");
+    descripcion = "";
+
+    if (isec.longitud() >= 3 && isec.longitud() % 3 == 0 && validador("ATG", idesc)) {
+        secuencia = move(isec);
         descripcion = idesc;
     }
 }
 
 // Constructor de copia
+// La otra cadena ya es válida: toda CadenaADN se valida al construirse
+// o modificarse, así que se copia directamente la secuencia empaquetada
 CadenaADN::CadenaADN(const CadenaADN &molecula) {
-    secuencia = "ATG"; 
-    descripcion = ""; 
-    
-    if (validador(molecula.secuencia, molecula.descripcion)) {
-        secuencia = molecula.secuencia; 
-        descripcion = molecula.descripcion;
-    }
+    secuencia = molecula.secuencia; 
+    descripcion = molecula.descripcion;
+    estadisticas = molecula.estadisticas;
+    indice = molecula.indice;
+}
+
+// Constructor de movimiento
+// Los miembros se construyen por movimiento, así que no se reserva nada
+// (tampoco el "ATG" por defecto). El origen queda vacío: longitud 0 y sin
+// estadísticas ni índices, listo para destruirse o recibir una asignación.
+CadenaADN::CadenaADN(CadenaADN &&molecula) noexcept
+    : secuencia(std::move(molecula.secuencia)), descripcion(std::move(molecula.descripcion)),
+      estadisticas(std::move(molecula.estadisticas)), indice(std::move(molecula.indice)) {
+    molecula.descripcion.clear();
+    molecula.estadisticas = Estadisticas();
 }
 
 // Destructor
@@ -97,9 +193,22 @@ CadenaADN::~CadenaADN() {
 
 // Operador de asignación
 CadenaADN& CadenaADN::operator=(const CadenaADN &molecula) {
-    if (validador(molecula.secuencia, molecula.descripcion)) {
+    if (this != &molecula) {
         secuencia = molecula.secuencia; 
         descripcion = molecula.descripcion;
+        estadisticas = molecula.estadisticas;
+        indice = molecula.indice;
+    }
+    return (*this);
+}
+
+// Asignación por movimiento
+CadenaADN& CadenaADN::operator=(CadenaADN &&molecula) noexcept {
+    if (this != &molecula) {
+        swap(secuencia, molecula.secuencia);
+        swap(descripcion, molecula.descripcion);
+        swap(estadisticas, molecula.estadisticas);
+        swap(indice, molecula.indice);
     }
     return (*this);
 }
@@ -122,21 +231,29 @@ bool CadenaADN::operator!=(const CadenaADN &molecula) const {
 // GETTERS Y SETTERS
 // =============================================
 
+// Decodifica la secuencia empaquetada bajo demanda
 string CadenaADN::getSecuencia() const { 
-    return secuencia; 
+    return secuencia.decodificar(); 
 }
 
-string CadenaADN::getDescripcion() const { 
+// Acceso directo a la representación empaquetada, sin decodificar
+const SecuenciaEmpaquetada& CadenaADN::getSecuenciaEmpaquetada() const {
+    return secuencia;
+}
+
+const string& CadenaADN::getDescripcion() const { 
     return descripcion; 
 }
 
 int CadenaADN::getLongitud() const { 
-    return secuencia.length();
+    return secuencia.longitud();
 }
 
 void CadenaADN::setSecuencia(const string &isec) { 
     if (validador(isec, "")) { 
-        secuencia = isec; 
+        secuencia.asignar(isec); 
+        invalidarEstadisticas();
+        indice.reset();
     }
 }
 
@@ -150,28 +267,39 @@ void CadenaADN::setDescripcion(const string &idesc) {
 // CONTEO DE NUCLEÓTIDOS
 // =============================================
 
+// Cuenta las cuatro bases en una sola pasada sobre la secuencia empaquetada
+// El resultado queda en caché hasta que se modifique la secuencia
+Composicion CadenaADN::composicion() const {
+    if (!estadisticas.cuentasValidas) {
+        estadisticas.composicion = secuencia.vista().composicion();
+        estadisticas.cuentasValidas = true;
+    }
+    return estadisticas.composicion;
+}
+
 int CadenaADN::cuentaA() const { 
-    return contador("A"); 
+    return composicion().cuentas[0]; 
 }
 
 int CadenaADN::cuentaT() const { 
-    return contador("T"); 
+    return composicion().cuentas[3]; 
 }
 
 int CadenaADN::cuentaC() const { 
-    return contador("C"); 
+    return composicion().cuentas[1]; 
 }
 
 int CadenaADN::cuentaG() const { 
-    return contador("G"); 
+    return composicion().cuentas[2]; 
 }
 
 // Verifica si cumple las proporciones de Chargaff
 bool CadenaADN::cumpleChargaff() const {
-    int numA = cuentaA();
-    int numT = cuentaT();
-    int numC = cuentaC();
-    int numG = cuentaG();
+    Composicion c = composicion();
+    int numA = c.cuentas[0];
+    int numT = c.cuentas[3];
+    int numC = c.cuentas[1];
+    int numG = c.cuentas[2];
     
     bool cond1 = (numA == numT);
     bool cond2 = (numC == numG);
@@ -182,9 +310,8 @@ bool CadenaADN::cumpleChargaff() const {
 
 // Calcula la proporción de G y C en la secuencia
 double CadenaADN::proporcionGC() const {
-    int cuentaGC = cuentaC() + cuentaG();
-    int total = cuentaGC + cuentaA() + cuentaT();
-    return ((double)cuentaGC / total);
+    Composicion c = composicion();
+    return ((double)c.gc() / c.total());
 }
 
 // =============================================
@@ -206,39 +333,34 @@ int CadenaADN::contarCodon(const string &icodon) const {
 
 // Busca la primera aparición de una subsecuencia
 int CadenaADN::buscarSubsecuencia(const string &serie) const { 
-    int posicion = -1;
-    int i = 0;
-    int longitud_serie = serie.length();
-    
-    if (longitud_serie == 0) { 
-        return posicion; 
-    }
-    
-    while (posicion == -1 && (i + longitud_serie) <= secuencia.length()) {
-        if (secuencia.substr(i, longitud_serie) == serie) { 
-            posicion = i; 
-        } else { 
-            i++; 
-        }
+    if (indice) {
+        return indice->primera(serie);
     }
-    return posicion;
+    return BuscadorPatron(serie).primera(secuencia.vista());
+}
+
+// Busca las apariciones con errores (distancia de edición <= maxErrores)
+vector<CoincidenciaAproximada> CadenaADN::buscarAproximada(const string &serie, int maxErrores) const {
+    vector<CoincidenciaAproximada> resultado;
+    BuscadorAproximado(serie, maxErrores).buscar(secuencia.vista(), 0, resultado);
+    return resultado;
 }
 
 // Busca la última aparición de una subsecuencia
+// Recorre la secuencia desde el final, así que para en la primera coincidencia
 int CadenaADN::posicionUltimaAparicion(const string &serie) const {
-    int posicion = -1;
-    int longitud_serie = serie.length();
-    
-    if (longitud_serie == 0) { 
-        return posicion; 
+    if (indice) {
+        return indice->ultima(serie);
     }
+    return BuscadorPatron(serie).ultima(secuencia.vista());
+}
 
-    for (int i = 0; (i + longitud_serie) <= secuencia.length(); i++) {
-        if (secuencia.substr(i, longitud_serie) == serie) {
-            posicion = i;
-        }
+// Devuelve las posiciones de todas las apariciones (solapadas) en una pasada
+vector<int> CadenaADN::buscarTodas(const string &serie) const {
+    if (indice) {
+        return indice->todas(serie);
     }
-    return posicion;
+    return BuscadorPatron(serie).todas(secuencia.vista());
 }
 
 // =============================================
@@ -247,54 +369,131 @@ int CadenaADN::posicionUltimaAparicion(const string &serie) const {
 
 // Encuentra la longitud máxima de nucleótidos consecutivos del mismo tipo
 int CadenaADN::longitudMaximaConsecutiva(char nucleo) const {
-    int actual = 0;
-    int maxima = 0;
-    
-    for (int i = 0; i < secuencia.length(); i++) {
-        if (secuencia[i] == nucleo) {
-            actual++;
-        } else {
-            if (actual > maxima) { 
-                maxima = actual;
-            }
-            actual = 0;
-        }
+    int codigo = SecuenciaEmpaquetada::codificar(nucleo);
+    if (codigo < 0) {
+        return 0;
     }
-    
-    // Verificar la última secuencia
-    if (actual > maxima) {
-        maxima = actual;
+    if (!estadisticas.rachasValidas) {
+        calcularRachas();
     }
-    
-    return maxima;
+    return estadisticas.rachaMaxima[codigo];
 }
 
 // Encuentra la longitud máxima de cualquier nucleótido consecutivo
 int CadenaADN::longitudMaximaConsecutivaCualquiera() const {
-    int maxA = longitudMaximaConsecutiva('A');
-    int maxT = longitudMaximaConsecutiva('T');
-    int maxC = longitudMaximaConsecutiva('C');
-    int maxG = longitudMaximaConsecutiva('G');
+    if (!estadisticas.rachasValidas) {
+        calcularRachas();
+    }
     
     // Encontrar el máximo de todos
-    int maximo = maxA;
-    if (maxT > maximo) maximo = maxT;
-    if (maxC > maximo) maximo = maxC;
-    if (maxG > maximo) maximo = maxG;
+    int maximo = 0;
+    for (int c = 0; c < 4; c++) {
+        if (estadisticas.rachaMaxima[c] > maximo) {
+            maximo = estadisticas.rachaMaxima[c];
+        }
+    }
     
     return maximo;
 }
 
+// Homopolímeros de al menos k bases. Con índice de rachas construido para
+// un mínimo no mayor que k se filtra el índice; si no, se recorre la secuencia
+vector<Racha> CadenaADN::homopolimeros(int k) const {
+    size_t minimo = (k < 1) ? 1 : k;
+    if (estadisticas.minimoIndice == 0 || minimo < estadisticas.minimoIndice) {
+        return secuencia.vista().rachas(minimo);
+    }
+    if (!estadisticas.homopolimerosValidos) {
+        estadisticas.homopolimeros = secuencia.vista().rachas(estadisticas.minimoIndice);
+        estadisticas.homopolimerosValidos = true;
+    }
+    vector<Racha> resultado;
+    for (const Racha &r : estadisticas.homopolimeros) {
+        if (r.longitud >= minimo) {
+            resultado.push_back(r);
+        }
+    }
+    return resultado;
+}
+
+void CadenaADN::construirIndiceRachas(int k) {
+    estadisticas.minimoIndice = (k < 1) ? 1 : k;
+    estadisticas.homopolimeros = secuencia.vista().rachas(estadisticas.minimoIndice);
+    estadisticas.homopolimerosValidos = true;
+}
+
+bool CadenaADN::tieneIndiceRachas() const {
+    return estadisticas.minimoIndice > 0;
+}
+
+void CadenaADN::descartarIndiceRachas() {
+    estadisticas.minimoIndice = 0;
+    estadisticas.homopolimeros.clear();
+    estadisticas.homopolimerosValidos = false;
+}
+
+// Tras cambiar la base 'pos' solo cambian las rachas que tocaban pos-1, pos
+// o pos+1: se sustituyen las entradas del índice en ese tramo por las que
+// resultan de volver a recorrerlo
+void CadenaADN::actualizarHomopolimeros(size_t pos) const {
+    VistaEmpaquetada v = secuencia.vista();
+    size_t ini = (pos > 0) ? pos - 1 : pos;
+    size_t fin = min(pos + 2, v.longitud());
+    while (ini > 0 && v.codigo(ini - 1) == v.codigo(ini)) {
+        ini--;
+    }
+    while (fin < v.longitud() && v.codigo(fin) == v.codigo(fin - 1)) {
+        fin++;
+    }
+
+    vector<Racha> &indice = estadisticas.homopolimeros;
+    auto porInicio = [](const Racha &r, size_t p) { return r.inicio < p; };
+    auto desde = lower_bound(indice.begin(), indice.end(), ini, porInicio);
+    auto hasta = lower_bound(desde, indice.end(), fin, porInicio);
+    vector<Racha> nuevas = v.rachas(estadisticas.minimoIndice, ini, fin);
+    desde = indice.erase(desde, hasta);
+    indice.insert(desde, nuevas.begin(), nuevas.end());
+}
+
 // =============================================
 // MUTACIONES
 // =============================================
 
 // Cambia un nucleótido en una posición específica
+// Las cuentas en caché se ajustan en O(1); las rachas se actualizan mirando
+// solo la racha afectada, salvo que la mutación rompa la racha máxima
 bool CadenaADN::mutar(int pos, char nucleo) {
     // Verificar que la posición sea válida y el nucleótido sea A,T,C o G
-    if (pos >= 0 && pos < secuencia.length() && 
+    if (pos >= 0 && pos < (int)secuencia.longitud() && 
         (nucleo == 'A' || nucleo == 'T' || nucleo == 'C' || nucleo == 'G')) {
-        secuencia[pos] = nucleo;
+        int anterior = secuencia.codigo(pos);
+        int nuevo = SecuenciaEmpaquetada::codificar(nucleo);
+        if (anterior == nuevo) {
+            return true;
+        }
+
+        if (estadisticas.rachasValidas && 
+            longitudRacha(pos, anterior) == estadisticas.rachaMaxima[anterior]) {
+            // Puede que fuera la única racha máxima: se recalculará al consultarla
+            estadisticas.rachasValidas = false;
+        }
+
+        secuencia.fijar(pos, nuevo);
+        indice.reset();
+
+        if (estadisticas.cuentasValidas) {
+            estadisticas.composicion.cuentas[anterior]--;
+            estadisticas.composicion.cuentas[nuevo]++;
+        }
+        if (estadisticas.rachasValidas) {
+            int racha = longitudRacha(pos, nuevo);
+            if (racha > estadisticas.rachaMaxima[nuevo]) {
+                estadisticas.rachaMaxima[nuevo] = racha;
+            }
+        }
+        if (estadisticas.homopolimerosValidos) {
+            actualizarHomopolimeros(pos);
+        }
         return true;
     } else {
         return false;
@@ -304,17 +503,12 @@ bool CadenaADN::mutar(int pos, char nucleo) {
 // Cuenta las diferencias entre esta secuencia y otra
 int CadenaADN::contarMutaciones(const CadenaADN &molecula) const {
     // Solo comparar si tienen la misma longitud
-    if (secuencia.length() != molecula.secuencia.length()) { 
+    if (secuencia.longitud() != molecula.secuencia.longitud()) { 
         return -1; 
     }
     
-    int diferencias = 0;
-    for (int i = 0; i < secuencia.length(); i++) {
-        if (secuencia[i] != molecula.secuencia[i]) { 
-            diferencias++; 
-        }
-    }
-    return diferencias; 
+    // XOR + popcount sobre las palabras empaquetadas
+    return secuencia.vista().distanciaHamming(molecula.secuencia.vista()); 
 }
 
 // =============================================
@@ -324,30 +518,37 @@ int CadenaADN::contarMutaciones(const CadenaADN &molecula) const {
 // Verifica si esta secuencia es complementaria de otra
 bool CadenaADN::esSecuenciaComplementaria(const CadenaADN& molecula) const {
     // Deben tener la misma longitud
-    if (secuencia.length() != molecula.secuencia.length()) { 
+    if (secuencia.longitud() != molecula.secuencia.longitud()) { 
         return false; 
     }
     
-    // Verificar cada par de nucleótidos
-    for (int i = 0; i < secuencia.length(); i++) {
-        switch (secuencia[i]) {
-            case 'A':
-                if (molecula.secuencia[i] != 'T') { return false; }
-                break;
-            case 'T':
-                if (molecula.secuencia[i] != 'A') { return false; }
-                break;
-            case 'C':
-                if (molecula.secuencia[i] != 'G') { return false; }
-                break;
-            case 'G':
-                if (molecula.secuencia[i] != 'C') { return false; }
-                break;
-            default:
-                return false;  // Carácter inválido
-        }
+    // Verificar 32 pares de nucleótidos por palabra (A-T y C-G difieren en todos los bits)
+    return secuencia.vista().esComplementaria(molecula.secuencia.vista());
+}
+
+// Verifica si esta secuencia es la complementaria inversa de otra
+bool CadenaADN::esComplementariaInversa(const CadenaADN& molecula) const {
+    if (secuencia.longitud() != molecula.secuencia.longitud()) {
+        return false;
     }
-    return true;
+    return secuencia.vista().esComplementariaInversa(molecula.secuencia.vista());
+}
+
+// Palíndromo en sentido biológico: igual a su complementaria inversa
+bool CadenaADN::esPalindromo() const {
+    return esComplementariaInversa(*this);
+}
+
+// Posiciones de las subsecuencias palindrómicas de la longitud dada (par)
+vector<int> CadenaADN::sitiosPalindromicos(int longitud) const {
+    vector<int> resultado;
+    if (longitud <= 0) {
+        return resultado;
+    }
+    for (size_t p : secuencia.vista().sitiosPalindromicos(longitud)) {
+        resultado.push_back((int)p);
+    }
+    return resultado;
 }
 
 // =============================================
@@ -355,23 +556,41 @@ bool CadenaADN::esSecuenciaComplementaria(const CadenaADN& molecula) const {
 // =============================================
 
 // Invierte la secuencia (A->T, T->A, C->G, G->C)
+// Con la codificación de 2 bits basta un XOR por palabra
+// Las estadísticas se conservan intercambiando A<->T y C<->G
 void CadenaADN::invertir() {
-    for (int i = 0; i < secuencia.length(); i++) {
-        switch (secuencia[i]) {
-            case 'A': 
-                secuencia[i] = 'T';
-                break;
-            case 'T':
-                secuencia[i] = 'A';
-                break;
-            case 'C':
-                secuencia[i] = 'G';
-                break;
-            case 'G':
-                secuencia[i] = 'C';
-                break;
-        }
-    }  
+    secuencia.complementar();
+    indice.reset();
+
+    Estadisticas anteriores = estadisticas;
+    for (int c = 0; c < 4; c++) {
+        estadisticas.composicion.cuentas[c] = anteriores.composicion.cuentas[3 - c];
+        estadisticas.rachaMaxima[c] = anteriores.rachaMaxima[3 - c];
+    }
+    for (Racha &r : estadisticas.homopolimeros) {
+        r.codigo = 3 - r.codigo;
+    }
+}
+
+// Sustituye la secuencia por su complementaria inversa. Las rachas no
+// cambian de longitud al leerse al revés, así que las estadísticas se
+// conservan igual que en invertir()
+void CadenaADN::complementarInverso() {
+    secuencia.complementarInverso();
+    indice.reset();
+
+    Estadisticas anteriores = estadisticas;
+    for (int c = 0; c < 4; c++) {
+        estadisticas.composicion.cuentas[c] = anteriores.composicion.cuentas[3 - c];
+        estadisticas.rachaMaxima[c] = anteriores.rachaMaxima[3 - c];
+    }
+    // Las rachas del índice se reflejan: la última pasa a ser la primera
+    size_t n = secuencia.longitud();
+    reverse(estadisticas.homopolimeros.begin(), estadisticas.homopolimeros.end());
+    for (Racha &r : estadisticas.homopolimeros) {
+        r.inicio = n - r.inicio - r.longitud;
+        r.codigo = 3 - r.codigo;
+    }
 }
 
 // =============================================
@@ -383,7 +602,7 @@ bool CadenaADN::guardarEnFichero(const string &path) const {
     ofstream fichero(path);
     if (fichero.is_open()) {
         fichero << descripcion << "\n";
-        fichero << secuencia << "\n";
+        fichero << secuencia.decodificar() << "\n";
         fichero.close();
         return true;
     } else { 
@@ -393,17 +612,24 @@ bool CadenaADN::guardarEnFichero(const string &path) const {
 }
 
 // Carga la cadena ADN desde un fichero
+// El contenido se valida antes de empaquetarlo; si no es válido no se modifica
 bool CadenaADN::cargarDesdeFichero(const string &path) {
     ifstream fichero(path);
     if (fichero.is_open()) {
         string linea_descripcion, linea_secuencia;
         getline(fichero, linea_descripcion);
         getline(fichero, linea_secuencia);
+        fichero.close();
         
+        if (!validador(linea_secuencia, linea_descripcion)) {
+            cout << "Error: el contenido del archivo no es válido.\n";
+            return false;
+        }
         descripcion = linea_descripcion;
-        secuencia = linea_secuencia;
+        secuencia.asignar(linea_secuencia);
+        invalidarEstadisticas();
+        indice.reset();
         
-        fichero.close();
         return true;
     } else { 
         cout << "Error al abrir el archivo.\n"; 
@@ -411,6 +637,46 @@ bool CadenaADN::cargarDesdeFichero(const string &path) {
     }
 }
 
+// =============================================
+// ÍNDICE FM
+// =============================================
+
+// Construye el índice de texto completo; desde ese momento contador,
+// contarCodon y las búsquedas de subsecuencias lo usan
+void CadenaADN::construirIndice() {
+    indice = make_shared<IndiceFM>(secuencia.vista());
+}
+
+bool CadenaADN::tieneIndice() const {
+    return indice != nullptr;
+}
+
+void CadenaADN::descartarIndice() {
+    indice.reset();
+}
+
+// Guarda el índice junto al fichero de guardarEnFichero (p.ej. "cadena.txt.fm")
+bool CadenaADN::guardarIndice(const string &path) const {
+    if (!indice) {
+        return false;
+    }
+    return indice->guardarEnFichero(path);
+}
+
+// Carga un índice guardado; solo se acepta si corresponde a esta secuencia
+bool CadenaADN::cargarIndice(const string &path) {
+    shared_ptr<IndiceFM> cargado = make_shared<IndiceFM>();
+    if (!cargado->cargarDesdeFichero(path, secuencia.longitud())) {
+        return false;
+    }
+    if (!cargado->correspondeA(secuencia.vista())) {
+        cout << "Error: el índice no corresponde a la secuencia.\n";
+        return false;
+    }
+    indice = cargado;
+    return true;
+}
+
 /*
  * =============================================
  * EJEMPLOS DE MÉTODOS PARA POSIBLE EXAMEN
@@ -5,41 +5,93 @@
 #include <fstream>
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <array>
+#include "SecuenciaEmpaquetada.h"
+#include "BuscadorAproximado.h"
+#include "CodigoGenetico.h"
 
 
 using namespace std;
 
+class IndiceFM;
+
 class CadenaADN {
     private:
-    string secuencia = "ATG";
+    SecuenciaEmpaquetada secuencia = SecuenciaEmpaquetada("ATG"); // 2 bits por base
     string descripcion = "";
+
+    // Estadísticas calculadas bajo demanda y mantenidas al modificar la cadena.
+    // Al ser una caché mutable, un mismo objeto no debe consultarse desde
+    // varios hilos a la vez sin sincronización.
+    struct Estadisticas {
+        Composicion composicion;
+        int rachaMaxima[4] = {0, 0, 0, 0}; // Homopolímero más largo por base
+        bool cuentasValidas = false;
+        bool rachasValidas = false;
+        // Índice opcional de homopolímeros de al menos 'minimoIndice' bases
+        // (0: sin índice), ordenado por posición y ajustado en cada mutar
+        size_t minimoIndice = 0;
+        vector<Racha> homopolimeros;
+        bool homopolimerosValidos = false;
+    };
+    mutable Estadisticas estadisticas;
+
+    // Índice de texto completo opcional; es inmutable, así que las copias lo
+    // comparten. Cualquier modificación de la secuencia lo descarta.
+    shared_ptr<const IndiceFM> indice;
+
+    void invalidarEstadisticas();
+    void calcularRachas() const;
+    void actualizarHomopolimeros(size_t) const;
+    int longitudRacha(size_t, int) const;
     public:
     // Auxiliares
     bool validador(const string &, const string &) const;
     int contador(const string &) const;
 
     vector<string> obtenerCodones() const;
+    VistaCodones codones() const;
+    array<int, 64> histogramaCodones() const;
+    //Traducción con el código genético estándar (marcos 1..3 y -1..-3)
+    string traducir(int marco = 1) const;
+    //Marcos abiertos de lectura en los seis marcos ('secuencia' vale 0)
+    vector<MarcoAbierto> buscarORFs(int minAminoacidos) const;
 
     //Constructor por defecto
     CadenaADN();
     //Constructor sobrecargado
     CadenaADN(const string &, const string &);
+    //Constructor desde bases ya empaquetadas: solo comprueba la longitud
+    //y la descripción, porque las bases siempre son válidas
+    CadenaADN(const VistaEmpaquetada &, const string &);
+    //Igual, pero adopta la secuencia sin copiarla (p.ej. la de un lector
+    //que ya ha validado el texto)
+    CadenaADN(SecuenciaEmpaquetada &&, const string &);
+    //La copia y la asignación no vuelven a validar: el origen ya es válido
     //Constructor de copia
     CadenaADN(const CadenaADN &);
+    //Constructor de movimiento: no reserva memoria; la cadena origen queda
+    //vacía (longitud 0) y solo debe destruirse o recibir una asignación
+    CadenaADN(CadenaADN &&) noexcept;
     //Destructor:
     ~CadenaADN();
     //Operador de asignación
     CadenaADN& operator=(const CadenaADN &);
+    //Asignación por movimiento: intercambia el contenido con el origen
+    CadenaADN& operator=(CadenaADN &&) noexcept;
     //Operadores de comparación
     bool operator==(const CadenaADN &) const;
     bool operator!=(const CadenaADN &) const;
     //Getters y setters
     string getSecuencia() const;
-    string getDescripcion() const;
+    const SecuenciaEmpaquetada& getSecuenciaEmpaquetada() const;
+    const string& getDescripcion() const;
     int getLongitud() const;
     void setSecuencia(const string &);
     void setDescripcion(const string &);
     //Cuentas de nucleótidos
+    Composicion composicion() const;
     int cuentaA() const;
     int cuentaT() const;
     int cuentaC() const;
@@ -51,19 +103,39 @@ class CadenaADN {
     //Búsqueda de subsecuencias
     int buscarSubsecuencia(const string &) const;
     int posicionUltimaAparicion(const string &) const;
+    vector<int> buscarTodas(const string &) const;
+    //Búsqueda con hasta maxErrores sustituciones, inserciones o borrados;
+    //devuelve la posición final de cada aparición ('secuencia' vale 0)
+    vector<CoincidenciaAproximada> buscarAproximada(const string &, int) const;
     //Búsqueda de elementos consecutivos
     int longitudMaximaConsecutiva(char) const;
     int longitudMaximaConsecutivaCualquiera() const;
+    //Homopolímeros de al menos k bases, en orden de posición
+    vector<Racha> homopolimeros(int) const;
+    void construirIndiceRachas(int);
+    bool tieneIndiceRachas() const;
+    void descartarIndiceRachas();
     //Mutaciones
     bool mutar(int, char);
     int contarMutaciones(const CadenaADN &) const;
     //Secuencias complementarias
     bool esSecuenciaComplementaria(const CadenaADN&) const;
+    //Complementaria inversa (la otra hebra leída en su sentido 5'->3')
+    bool esComplementariaInversa(const CadenaADN&) const;
+    bool esPalindromo() const;
+    vector<int> sitiosPalindromicos(int) const;
     //Modificaciones
     void invertir();
+    void complementarInverso();
     //Almacenaje y lectura de fichero
     bool guardarEnFichero(const string &) const;
     bool cargarDesdeFichero(const string &);
+    //Índice FM para consultas repetidas
+    void construirIndice();
+    bool tieneIndice() const;
+    void descartarIndice();
+    bool guardarIndice(const string &) const;
+    bool cargarIndice(const string &);
 };
 
 #endif // CADENAADN_H
@@ -0,0 +1,122 @@
+#include "CodigoGenetico.h"
+#include <algorithm>
+using namespace std;
+
+// Aminoácido de cada codón en orden AAA, AAC, AAG, AAT, ACA, ... (código estándar)
+static const char TABLA[] = "KNKNTTTTRSRSIIMIQHQHPPPPRRRRLLLLEDEDAAAAGGGGVVVV*Y*YSSSS*CWCLFLF";
+
+// Bit bajo de cada base de una palabra
+static const uint64_t BITS_BAJOS = 0x5555555555555555ULL;
+
+char CodigoGenetico::aminoacido(int codon) {
+    return (codon < 0 || codon > 63) ? '\0' : TABLA[codon];
+}
+
+bool CodigoGenetico::esInicio(int codon) {
+    return codon == 14; // ATG = 00 11 10
+}
+
+bool CodigoGenetico::esParada(int codon) {
+    return aminoacido(codon) == PARADA;
+}
+
+// Codón que empieza en la base i de la vista
+static inline int codonEn(const VistaEmpaquetada &v, size_t i) {
+    return (v.codigo(i) << 4) | (v.codigo(i + 1) << 2) | v.codigo(i + 2);
+}
+
+string CodigoGenetico::traducir(const VistaEmpaquetada &v, int marco) {
+    string proteina;
+    if (marco == 0 || marco < -3 || marco > 3) {
+        return proteina;
+    }
+    VistaEmpaquetada hebra = v;
+    vector<uint64_t> inverso;
+    if (marco < 0) {
+        inverso.resize(v.numPalabras());
+        v.complementoInverso(inverso.data());
+        hebra.palabras = inverso.data();
+    }
+    size_t desde = (marco < 0 ? -marco : marco) - 1;
+    for (size_t i = desde; i + 3 <= hebra.longitud(); i += 3) {
+        proteina += TABLA[codonEn(hebra, i)];
+    }
+    return proteina;
+}
+
+// Bit 2j a 1 si la base j de x es 'codigo' (comparación de 32 bases a la vez)
+static inline uint64_t igualA(uint64_t x, int codigo) {
+    uint64_t y = ~(x ^ (BITS_BAJOS * (uint64_t)codigo));
+    return y & (y >> 1) & BITS_BAJOS;
+}
+
+// ORF de los tres marcos de una hebra. Para cada bloque de 32 posiciones se
+// calculan con operaciones de palabra las máscaras de ATG y de paradas
+// (TAA, TAG, TGA) que empiezan en ellas; después se recorren solo esos bits.
+// En cada marco se recuerda el primer ATG desde la última parada.
+static void orfsHebra(const VistaEmpaquetada &v, size_t minAminoacidos, int idSecuencia, bool inversa,
+                      vector<MarcoAbierto> &resultado) {
+    size_t n = v.longitud();
+    if (n < 6) {
+        return;
+    }
+    const size_t ultimoCodon = n - 3; // Última posición donde empieza un codón
+    long long pendiente[3] = {-1, -1, -1};
+
+    for (size_t bloque = 0; bloque <= ultimoCodon; bloque += 32) {
+        uint64_t b0 = v.basesDesde(bloque);
+        uint64_t b1 = (bloque + 1 < n) ? v.basesDesde(bloque + 1) : 0;
+        uint64_t b2 = (bloque + 2 < n) ? v.basesDesde(bloque + 2) : 0;
+        uint64_t inicios = igualA(b0, 0) & igualA(b1, 3) & igualA(b2, 2);
+        uint64_t paradas = igualA(b0, 3) & ((igualA(b1, 0) & (igualA(b2, 0) | igualA(b2, 2))) |
+                                            (igualA(b1, 2) & igualA(b2, 0)));
+        size_t cuantas = min<size_t>(32, ultimoCodon - bloque + 1);
+        if (cuantas < 32) {
+            uint64_t dentro = (1ULL << (2 * cuantas)) - 1;
+            inicios &= dentro;
+            paradas &= dentro;
+        }
+
+        for (uint64_t eventos = inicios | paradas; eventos != 0; eventos &= eventos - 1) {
+            int bit = __builtin_ctzll(eventos);
+            size_t pos = bloque + (bit >> 1);
+            int m = pos % 3;
+            if ((inicios >> bit) & 1) {
+                if (pendiente[m] < 0) {
+                    pendiente[m] = pos;
+                }
+                continue;
+            }
+            if (pendiente[m] >= 0 && (pos - pendiente[m]) / 3 >= minAminoacidos) {
+                MarcoAbierto orf;
+                orf.secuencia = idSecuencia;
+                orf.marco = inversa ? -(m + 1) : (m + 1);
+                orf.inicio = pendiente[m];
+                orf.fin = pos + 3;
+                resultado.push_back(orf);
+            }
+            pendiente[m] = -1;
+        }
+    }
+}
+
+static void ordenarPorInicio(vector<MarcoAbierto> &orfs, size_t desde) {
+    stable_sort(orfs.begin() + desde, orfs.end(), [](const MarcoAbierto &a, const MarcoAbierto &b) {
+        return a.inicio < b.inicio;
+    });
+}
+
+void CodigoGenetico::buscarORFs(const VistaEmpaquetada &v, size_t minAminoacidos, int idSecuencia,
+                                vector<MarcoAbierto> &resultado) {
+    size_t desde = resultado.size();
+    orfsHebra(v, minAminoacidos, idSecuencia, false, resultado);
+    ordenarPorInicio(resultado, desde);
+
+    vector<uint64_t> inverso(v.numPalabras());
+    v.complementoInverso(inverso.data());
+    VistaEmpaquetada hebra = v;
+    hebra.palabras = inverso.data();
+    desde = resultado.size();
+    orfsHebra(hebra, minAminoacidos, idSecuencia, true, resultado);
+    ordenarPorInicio(resultado, desde);
+}
@@ -0,0 +1,47 @@
+#ifndef CODIGOGENETICO_H
+#define CODIGOGENETICO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Marco abierto de lectura (ORF): de un ATG al primer codón de parada en el
+// mismo marco, incluido. 'marco' es 1, 2 o 3 en la hebra directa (posición
+// % 3 + 1) y -1, -2 o -3 en la complementaria inversa; 'inicio' y 'fin'
+// (exclusivo) se cuentan sobre esa hebra. 'secuencia' es el registro.
+struct MarcoAbierto {
+    int secuencia;
+    int marco;
+    size_t inicio;
+    size_t fin;
+
+    size_t aminoacidos() const { return (fin - inicio) / 3 - 1; } // Sin la parada
+};
+
+// Código genético estándar sobre codones de 6 bits (primera base en los bits
+// altos, como en SecuenciaEmpaquetada::codificarCodon): traducir un codón es
+// consultar una tabla de 64 entradas, sin crear cadenas.
+class CodigoGenetico {
+    public:
+    static const char PARADA = '*';
+
+    static char aminoacido(int codon);
+    static bool esInicio(int codon);  // ATG
+    static bool esParada(int codon);  // TAA, TAG, TGA
+
+    // Proteína del marco indicado (1..3 directos, -1..-3 sobre la
+    // complementaria inversa), con '*' en las paradas; vacía si no es válido
+    static string traducir(const VistaEmpaquetada &, int marco);
+
+    // Añade a 'resultado' los ORF de los seis marcos con al menos
+    // 'minAminoacidos' aminoácidos: primero los de la hebra directa y luego
+    // los de la inversa, cada grupo por inicio. Los ATG y las paradas se
+    // localizan 32 posiciones a la vez con operaciones de palabra.
+    static void buscarORFs(const VistaEmpaquetada &, size_t minAminoacidos, int idSecuencia,
+                           vector<MarcoAbierto> &resultado);
+};
+
+#endif // CODIGOGENETICO_H
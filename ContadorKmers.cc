@@ -0,0 +1,256 @@
+#include "ContadorKmers.h"
+#include "Paralelo.h"
+#include <algorithm>
+using namespace std;
+
+// Con k <= 31 ninguna clave tiene los dos bits altos a 1
+static const uint64_t VACIA = ~0ULL;
+
+static inline uint64_t dispersar(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+ContadorKmers::ContadorKmers(int ik, bool icanonicos)
+    : k(ik), canonicos(icanonicos), mascara(0), numDistintos(0), numTotal(0) {
+    if (esValido()) {
+        mascara = (1ULL << (2 * k)) - 1;
+    }
+}
+
+ContadorKmers::ContadorKmers(ContadorKmers &&otro) noexcept
+    : k(otro.k), canonicos(otro.canonicos), mascara(otro.mascara),
+      claves(std::move(otro.claves)), cuentas(std::move(otro.cuentas)),
+      numDistintos(otro.numDistintos.load()), numTotal(otro.numTotal) {
+    otro.numDistintos = 0;
+    otro.numTotal = 0;
+}
+
+bool ContadorKmers::esValido() const {
+    return k >= 1 && k <= 31;
+}
+
+int ContadorKmers::getK() const {
+    return k;
+}
+
+bool ContadorKmers::sonCanonicos() const {
+    return canonicos;
+}
+
+// La tabla no crece mientras se cuenta: antes de cada ronda se amplía, si
+// hace falta, para que quepan todos los k-mers nuevos posibles de la ronda
+// con una ocupación de como mucho la mitad
+void ContadorKmers::asegurarCapacidad(size_t nuevos) {
+    nuevos = min<uint64_t>(nuevos, mascara + 1);
+    size_t necesaria = 16;
+    while (necesaria < 2 * (numDistintos + nuevos)) {
+        necesaria *= 2;
+    }
+    if (necesaria <= claves.size()) {
+        return;
+    }
+
+    vector<atomic<uint64_t> > viejasClaves(necesaria), viejasCuentas(necesaria);
+    viejasClaves.swap(claves);
+    viejasCuentas.swap(cuentas);
+    for (size_t i = 0; i < necesaria; i++) {
+        claves[i].store(VACIA, memory_order_relaxed);
+        cuentas[i].store(0, memory_order_relaxed);
+    }
+    numDistintos = 0;
+    for (size_t i = 0; i < viejasClaves.size(); i++) {
+        uint64_t clave = viejasClaves[i].load(memory_order_relaxed);
+        if (clave != VACIA) {
+            sumar(clave, viejasCuentas[i].load(memory_order_relaxed));
+        }
+    }
+}
+
+// Sondeo lineal; una entrada libre se reclama con compare_exchange
+void ContadorKmers::sumar(uint64_t clave, uint64_t cantidad) {
+    size_t limite = claves.size() - 1;
+    for (size_t h = dispersar(clave) & limite;; h = (h + 1) & limite) {
+        uint64_t actual = claves[h].load(memory_order_acquire);
+        if (actual == VACIA) {
+            if (claves[h].compare_exchange_strong(actual, clave, memory_order_acq_rel)) {
+                numDistintos++;
+                actual = clave;
+            }
+        }
+        if (actual == clave) {
+            cuentas[h].fetch_add(cantidad, memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+// Agrupa las repeticiones del lote y suma cada clave una sola vez
+void ContadorKmers::volcar(vector<pair<uint64_t, uint64_t> > &lote) {
+    sort(lote.begin(), lote.end());
+    for (size_t i = 0; i < lote.size();) {
+        uint64_t cantidad = 0;
+        size_t j = i;
+        for (; j < lote.size() && lote[j].first == lote[i].first; j++) {
+            cantidad += lote[j].second;
+        }
+        sumar(lote[i].first, cantidad);
+        i = j;
+    }
+    lote.clear();
+}
+
+// Las secuencias se parten en tramos (solapados k-1 bases) para repartir
+// también el trabajo de una sola secuencia larga entre los hilos. Los tramos
+// se cuentan por rondas: cada ronda abarca como mucho los k-mers que caben en
+// el hueco libre de la tabla (o POSICIONES_RONDA, si es mayor), y la tabla
+// solo se amplía entre rondas, cuando no hay ningún hilo trabajando. Con
+// mucha cobertura casi todos los k-mers ya están en la tabla y las rondas
+// siguientes no la hacen crecer.
+void ContadorKmers::contar(const vector<VistaEmpaquetada> &secuencias, const vector<uint64_t> &pesos) {
+    if (!esValido()) {
+        return;
+    }
+    struct Tramo {
+        size_t secuencia, ini, fin; // Bases [ini, fin)
+    };
+    vector<Tramo> tramos;
+    for (size_t s = 0; s < secuencias.size(); s++) {
+        size_t n = secuencias[s].longitud();
+        if (n < (size_t)k || pesos[s] == 0) {
+            continue;
+        }
+        numTotal += (n - k + 1) * pesos[s];
+        for (size_t ini = 0; ini + k <= n; ini += BASES_TRAMO) {
+            Tramo t = {s, ini, min(n, ini + BASES_TRAMO + k - 1)};
+            tramos.push_back(t);
+        }
+    }
+
+    const int desp = 2 * (k - 1);
+    for (size_t primero = 0; primero < tramos.size();) {
+        size_t hueco = claves.size() / 2 > numDistintos ? claves.size() / 2 - numDistintos : 0;
+        size_t limite = max(hueco, (size_t)POSICIONES_RONDA);
+        size_t ultimo = primero, posiciones = 0;
+        while (ultimo < tramos.size() && (ultimo == primero || posiciones + BASES_TRAMO <= limite)) {
+            posiciones += tramos[ultimo].fin - tramos[ultimo].ini - k + 1;
+            ultimo++;
+        }
+        asegurarCapacidad(posiciones);
+
+        paraleloPorBloques(ultimo - primero, 16, [&](size_t ini, size_t fin) {
+            vector<pair<uint64_t, uint64_t> > lote;
+            lote.reserve(TAM_LOTE);
+            for (size_t t = primero + ini; t < primero + fin; t++) {
+                const VistaEmpaquetada &v = secuencias[tramos[t].secuencia];
+                uint64_t peso = pesos[tramos[t].secuencia];
+                uint64_t directo = 0, inverso = 0;
+                for (size_t i = tramos[t].ini; i < tramos[t].fin; i++) {
+                    uint64_t c = v.codigo(i);
+                    directo = ((directo << 2) | c) & mascara;
+                    inverso = (inverso >> 2) | ((3 - c) << desp);
+                    if (i + 1 < tramos[t].ini + k) {
+                        continue;
+                    }
+                    lote.push_back(make_pair((canonicos && inverso < directo) ? inverso : directo, peso));
+                    if (lote.size() == TAM_LOTE) {
+                        volcar(lote);
+                    }
+                }
+            }
+            volcar(lote);
+        });
+        primero = ultimo;
+    }
+}
+
+void ContadorKmers::contar(const VistaEmpaquetada &v, uint64_t peso) {
+    contar(vector<VistaEmpaquetada>(1, v), vector<uint64_t>(1, peso));
+}
+
+// -1 (VACIA) si el k-mer no es válido
+uint64_t ContadorKmers::claveDe(const string &kmer) const {
+    if (!esValido() || kmer.length() != (size_t)k) {
+        return VACIA;
+    }
+    uint64_t directo = 0, inverso = 0;
+    for (char base : kmer) {
+        int c = SecuenciaEmpaquetada::codificar(base);
+        if (c < 0) {
+            return VACIA;
+        }
+        directo = (directo << 2) | c;
+        inverso = (inverso >> 2) | ((uint64_t)(3 - c) << (2 * (k - 1)));
+    }
+    return (canonicos && inverso < directo) ? inverso : directo;
+}
+
+uint64_t ContadorKmers::cuenta(const string &kmer) const {
+    uint64_t clave = claveDe(kmer);
+    if (clave == VACIA || claves.empty()) {
+        return 0;
+    }
+    size_t limite = claves.size() - 1;
+    for (size_t h = dispersar(clave) & limite;; h = (h + 1) & limite) {
+        uint64_t actual = claves[h].load(memory_order_relaxed);
+        if (actual == clave) {
+            return cuentas[h].load(memory_order_relaxed);
+        }
+        if (actual == VACIA) {
+            return 0;
+        }
+    }
+}
+
+size_t ContadorKmers::distintos() const {
+    return numDistintos;
+}
+
+uint64_t ContadorKmers::total() const {
+    return numTotal;
+}
+
+vector<pair<string, uint64_t> > ContadorKmers::masFrecuentes(size_t n) const {
+    vector<pair<uint64_t, uint64_t> > entradas; // (cuenta, clave)
+    for (size_t h = 0; h < claves.size(); h++) {
+        uint64_t clave = claves[h].load(memory_order_relaxed);
+        if (clave != VACIA) {
+            entradas.push_back(make_pair(cuentas[h].load(memory_order_relaxed), clave));
+        }
+    }
+    auto antes = [](const pair<uint64_t, uint64_t> &a, const pair<uint64_t, uint64_t> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    };
+    n = min(n, entradas.size());
+    partial_sort(entradas.begin(), entradas.begin() + n, entradas.end(), antes);
+
+    vector<pair<string, uint64_t> > resultado;
+    for (size_t i = 0; i < n; i++) {
+        resultado.push_back(make_pair(decodificar(entradas[i].second), entradas[i].first));
+    }
+    return resultado;
+}
+
+vector<uint64_t> ContadorKmers::histograma(size_t maximo) const {
+    vector<uint64_t> h(maximo + 1, 0);
+    if (maximo == 0) {
+        return h;
+    }
+    for (size_t i = 0; i < claves.size(); i++) {
+        if (claves[i].load(memory_order_relaxed) != VACIA) {
+            h[min<uint64_t>(cuentas[i].load(memory_order_relaxed), maximo)]++;
+        }
+    }
+    return h;
+}
+
+string ContadorKmers::decodificar(uint64_t clave) const {
+    string kmer(k, 'A');
+    for (int i = k - 1; i >= 0; i--) {
+        kmer[i] = SecuenciaEmpaquetada::decodificarBase(clave & 3);
+        clave >>= 2;
+    }
+    return kmer;
+}
@@ -0,0 +1,66 @@
+#ifndef CONTADORKMERS_H
+#define CONTADORKMERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Conteo de k-mers (k de 1 a 31) sobre secuencias empaquetadas. Cada k-mer
+// se guarda como clave de 2k bits con la primera base en los bits altos (el
+// orden numérico es el alfabético). En modo canónico un k-mer y su
+// complementario inverso cuentan como el mismo: se guarda el menor de los dos.
+// Las cuentas van en una tabla hash de direccionamiento abierto con entradas
+// atómicas. Cada bloque de trabajo acumula primero sus k-mers en un lote
+// propio, los agrupa y solo entonces los vuelca a la tabla, así que los
+// hilos apenas compiten por las mismas entradas. Los tramos se cuentan por
+// rondas y la tabla crece entre ellas según los k-mers distintos vistos, así
+// que la memoria depende de los distintos y no del total de posiciones.
+class ContadorKmers {
+    private:
+    int k;
+    bool canonicos;
+    uint64_t mascara;                 // 2k bits a 1
+    vector<atomic<uint64_t> > claves; // VACIA si la entrada está libre
+    vector<atomic<uint64_t> > cuentas;
+    atomic<size_t> numDistintos;
+    uint64_t numTotal;
+
+    static const size_t TAM_LOTE = 4096;    // k-mers por lote antes de volcar
+    static const size_t BASES_TRAMO = 1 << 16; // Reparto de secuencias largas
+    static const size_t POSICIONES_RONDA = 1 << 21; // Mínimo de k-mers por ronda
+
+    void asegurarCapacidad(size_t nuevos);
+    void sumar(uint64_t clave, uint64_t cantidad);
+    void volcar(vector<pair<uint64_t, uint64_t> > &lote);
+    uint64_t claveDe(const string &) const;
+    public:
+    explicit ContadorKmers(int k, bool canonicos = true);
+    ContadorKmers(ContadorKmers &&) noexcept;
+
+    bool esValido() const;
+    int getK() const;
+    bool sonCanonicos() const;
+
+    // Cuenta los k-mers de cada secuencia 'pesos[i]' veces, en paralelo
+    void contar(const vector<VistaEmpaquetada> &secuencias, const vector<uint64_t> &pesos);
+    void contar(const VistaEmpaquetada &, uint64_t peso = 1);
+
+    // Apariciones del k-mer (o de su clase canónica); 0 si no es válido
+    uint64_t cuenta(const string &) const;
+    size_t distintos() const;
+    uint64_t total() const;
+    // Los n k-mers más frecuentes; a igual cuenta, en orden alfabético
+    vector<pair<string, uint64_t> > masFrecuentes(size_t n) const;
+    // h[c]: k-mers distintos que aparecen c veces (c = 1..maximo; el último
+    // intervalo acumula también los que aparecen más veces). h[0] no se usa.
+    vector<uint64_t> histograma(size_t maximo) const;
+
+    string decodificar(uint64_t clave) const;
+};
+
+#endif // CONTADORKMERS_H
@@ -0,0 +1,236 @@
+#include "CuerdaADN.h"
+#include "Paralelo.h"
+#include <algorithm>
+using namespace std;
+
+CuerdaADN::CuerdaADN() : inicios(1, 0) {}
+
+// Los trozos vacíos no aportan nada y complicarían los recorridos
+void CuerdaADN::anadir(const VistaEmpaquetada &v) {
+    if (v.longitud() == 0) {
+        return;
+    }
+    trozos.push_back(v);
+    inicios.push_back(inicios.back() + v.longitud());
+}
+
+void CuerdaADN::anadir(const CuerdaADN &otra) {
+    for (const VistaEmpaquetada &v : otra.trozos) {
+        anadir(v);
+    }
+}
+
+size_t CuerdaADN::longitud() const {
+    return inicios.back();
+}
+
+size_t CuerdaADN::numTrozos() const {
+    return trozos.size();
+}
+
+const VistaEmpaquetada &CuerdaADN::trozo(size_t t) const {
+    return trozos[t];
+}
+
+// Trozo que contiene la posición global i (i < longitud())
+size_t CuerdaADN::trozoDe(size_t i) const {
+    return upper_bound(inicios.begin(), inicios.end(), i) - inicios.begin() - 1;
+}
+
+int CuerdaADN::codigo(size_t i) const {
+    size_t t = trozoDe(i);
+    return trozos[t].codigo(i - inicios[t]);
+}
+
+char CuerdaADN::base(size_t i) const {
+    return SecuenciaEmpaquetada::decodificarBase(codigo(i));
+}
+
+// Suma de las composiciones de los trozos, en paralelo por bloques de trozos
+Composicion CuerdaADN::composicion() const {
+    return reducirPorBloques(trozos.size(), 256, Composicion(), [&](size_t ini, size_t fin) {
+        Composicion parcial;
+        for (size_t t = ini; t < fin; t++) {
+            Composicion c = trozos[t].composicion();
+            for (int b = 0; b < 4; b++) {
+                parcial.cuentas[b] += c.cuentas[b];
+            }
+        }
+        return parcial;
+    }, [](Composicion a, const Composicion &b) {
+        for (int k = 0; k < 4; k++) {
+            a.cuentas[k] += b.cuentas[k];
+        }
+        return a;
+    });
+}
+
+// =============================================
+// CODONES
+// =============================================
+
+CuerdaADN::Codones CuerdaADN::codones() const {
+    return Codones(this);
+}
+
+CuerdaADN::Codones::iterador::iterador(const CuerdaADN *c, size_t ik) : cuerda(c), trozo(0), desplazamiento(0), k(ik) {
+    if (k > 0 && 3 * k < cuerda->longitud()) {
+        trozo = cuerda->trozoDe(3 * k);
+        desplazamiento = 3 * k - cuerda->inicios[trozo];
+    }
+}
+
+int CuerdaADN::Codones::iterador::operator*() const {
+    const VistaEmpaquetada &v = cuerda->trozos[trozo];
+    if (desplazamiento + 3 <= v.longitud()) {
+        return (v.codigo(desplazamiento) << 4) | (v.codigo(desplazamiento + 1) << 2) | v.codigo(desplazamiento + 2);
+    }
+    // El codón cruza a los trozos siguientes
+    int cod = 0;
+    size_t t = trozo, d = desplazamiento;
+    for (int j = 0; j < 3; j++) {
+        while (d >= cuerda->trozos[t].longitud()) {
+            d -= cuerda->trozos[t].longitud();
+            t++;
+        }
+        cod = (cod << 2) | cuerda->trozos[t].codigo(d);
+        d++;
+    }
+    return cod;
+}
+
+CuerdaADN::Codones::iterador &CuerdaADN::Codones::iterador::operator++() {
+    k++;
+    desplazamiento += 3;
+    while (trozo < cuerda->trozos.size() && desplazamiento >= cuerda->trozos[trozo].longitud()) {
+        desplazamiento -= cuerda->trozos[trozo].longitud();
+        trozo++;
+    }
+    return *this;
+}
+
+// =============================================
+// BÚSQUEDA
+// =============================================
+
+// Llama a f(posicion) por cada aparición, de izquierda a derecha, hasta
+// terminar o hasta que f devuelva false. El estado del autómata pasa de un
+// trozo al siguiente, así que se encuentran las apariciones que los cruzan.
+template <typename F>
+void CuerdaADN::recorrerCoincidencias(const string &patron, F f) const {
+    vector<int> codigos;
+    for (char c : patron) {
+        int cod = SecuenciaEmpaquetada::codificar(c);
+        if (cod < 0) {
+            return;
+        }
+        codigos.push_back(cod);
+    }
+    size_t m = codigos.size();
+    if (m == 0 || m > longitud()) {
+        return;
+    }
+
+    if (m <= 64) {
+        // Shift-Or: bit j a 0 si el patrón coincide hasta j terminando aquí
+        uint64_t mascaras[4] = {~0ULL, ~0ULL, ~0ULL, ~0ULL};
+        for (size_t j = 0; j < m; j++) {
+            mascaras[codigos[j]] &= ~(1ULL << j);
+        }
+        const uint64_t fin = 1ULL << (m - 1);
+        uint64_t estado = ~0ULL;
+        for (size_t t = 0; t < trozos.size(); t++) {
+            const VistaEmpaquetada &v = trozos[t];
+            size_t i = 0;
+            for (size_t w = 0; w < v.numPalabras(); w++) {
+                uint64_t palabra = v.palabras[w];
+                size_t limite = min<size_t>(32, v.longitud() - i);
+                for (size_t b = 0; b < limite; b++, i++, palabra >>= 2) {
+                    estado = (estado << 1) | mascaras[palabra & 3];
+                    if (!(estado & fin) && !f(inicios[t] + i + 1 - m)) {
+                        return;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // KMP sobre los códigos para patrones largos
+    vector<size_t> fallo(m, 0);
+    for (size_t j = 1, q = 0; j < m; j++) {
+        while (q > 0 && codigos[j] != codigos[q]) {
+            q = fallo[q - 1];
+        }
+        if (codigos[j] == codigos[q]) {
+            q++;
+        }
+        fallo[j] = q;
+    }
+    size_t q = 0;
+    for (size_t t = 0; t < trozos.size(); t++) {
+        const VistaEmpaquetada &v = trozos[t];
+        for (size_t i = 0; i < v.longitud(); i++) {
+            int c = v.codigo(i);
+            while (q > 0 && c != codigos[q]) {
+                q = fallo[q - 1];
+            }
+            if (c == codigos[q]) {
+                q++;
+            }
+            if (q == m) {
+                if (!f(inicios[t] + i + 1 - m)) {
+                    return;
+                }
+                q = fallo[q - 1];
+            }
+        }
+    }
+}
+
+size_t CuerdaADN::contar(const string &patron) const {
+    size_t total = 0;
+    recorrerCoincidencias(patron, [&](size_t) { total++; return true; });
+    return total;
+}
+
+long long CuerdaADN::primera(const string &patron) const {
+    long long pos = -1;
+    recorrerCoincidencias(patron, [&](size_t p) { pos = p; return false; });
+    return pos;
+}
+
+vector<size_t> CuerdaADN::buscarTodas(const string &patron) const {
+    vector<size_t> posiciones;
+    recorrerCoincidencias(patron, [&](size_t p) { posiciones.push_back(p); return true; });
+    return posiciones;
+}
+
+// =============================================
+// SALIDA
+// =============================================
+
+void CuerdaADN::escribir(ostream &salida) const {
+    static const size_t TAM_BLOQUE = 1 << 16;
+    string bloque;
+    bloque.reserve(TAM_BLOQUE);
+    for (const VistaEmpaquetada &v : trozos) {
+        for (size_t i = 0; i < v.longitud(); i++) {
+            bloque += SecuenciaEmpaquetada::decodificarBase(v.codigo(i));
+            if (bloque.size() == TAM_BLOQUE) {
+                salida.write(bloque.data(), bloque.size());
+                bloque.clear();
+            }
+        }
+    }
+    salida.write(bloque.data(), bloque.size());
+}
+
+SecuenciaEmpaquetada CuerdaADN::empaquetar() const {
+    SecuenciaEmpaquetada resultado;
+    resultado.reservar(longitud());
+    for (const VistaEmpaquetada &v : trozos) {
+        resultado.anadir(v);
+    }
+    return resultado;
+}
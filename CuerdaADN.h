@@ -0,0 +1,74 @@
+#ifndef CUERDAADN_H
+#define CUERDAADN_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Concatenación perezosa (cuerda) de secuencias empaquetadas: guarda solo
+// las vistas de cada trozo y la posición global donde empieza cada uno, sin
+// copiar bases. Las consultas recorren los trozos en orden, así que nunca se
+// construye la secuencia completa en memoria.
+// Las vistas no poseen la memoria: la cuerda es válida mientras no cambie el
+// origen de sus trozos (por ejemplo, la ListaCadenasADN de la que sale).
+class CuerdaADN {
+    private:
+    vector<VistaEmpaquetada> trozos;
+    vector<size_t> inicios; // inicios[t]: posición global del trozo t (uno más al final)
+
+    size_t trozoDe(size_t) const;
+    template <typename F> void recorrerCoincidencias(const string &, F) const;
+    public:
+    // Codones en marco de toda la cuerda (bases 3k..3k+2), aunque crucen de
+    // un trozo a otro, como enteros 0..63
+    class Codones {
+        const CuerdaADN *cuerda;
+        public:
+        class iterador {
+            const CuerdaADN *cuerda;
+            size_t trozo, desplazamiento; // Primera base del codón actual
+            size_t k;
+            public:
+            iterador(const CuerdaADN *, size_t);
+            int operator*() const;
+            iterador &operator++();
+            bool operator==(const iterador &o) const { return k == o.k; }
+            bool operator!=(const iterador &o) const { return k != o.k; }
+        };
+        explicit Codones(const CuerdaADN *c) : cuerda(c) {}
+        size_t size() const { return cuerda->longitud() / 3; }
+        iterador begin() const { return iterador(cuerda, 0); }
+        iterador end() const { return iterador(cuerda, size()); }
+    };
+
+    CuerdaADN();
+
+    void anadir(const VistaEmpaquetada &);
+    void anadir(const CuerdaADN &);
+
+    size_t longitud() const;
+    size_t numTrozos() const;
+    const VistaEmpaquetada &trozo(size_t) const;
+    int codigo(size_t) const;   // O(log trozos)
+    char base(size_t) const;
+
+    Composicion composicion() const;
+    Codones codones() const;
+
+    // Búsqueda exacta en la secuencia completa (las apariciones pueden cruzar
+    // trozos). Shift-Or hasta 64 bases y KMP para patrones más largos.
+    size_t contar(const string &) const;
+    long long primera(const string &) const; // -1 si no aparece
+    vector<size_t> buscarTodas(const string &) const;
+
+    // Escribe las bases por bloques, sin decodificar la cuerda entera
+    void escribir(ostream &) const;
+    // Copia empaquetada de toda la secuencia (4 bases por byte)
+    SecuenciaEmpaquetada empaquetar() const;
+};
+
+#endif // CUERDAADN_H
@@ -1,8 +1,13 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <fstream>
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
 #include "CadenaADN.h"
 #include "ListaCadenasADN.h"
+#include "InstantaneaADN.h"
 using namespace std;
 
 /* ========= Clase auxiliar para pruebas ========= */
@@ -243,6 +248,411 @@ int main() {
     test.expectEqualVec(obtenerSecuencias(lista12), {"ATG", "GATATCATC", "GCATCG", "CCTAGAATC"}, "eliminaDuplicados");
     test.expectEqualVec(obtenerSecuenciasInversa(lista12), {"CCTAGAATC", "GCATCG", "GATATCATC",  "ATG" }, "eliminaDuplicados (orden inverso)");
 
+    // --- Almacenamiento empaquetado (2 bits por base) ---
+    CadenaADN larga("ACGTACGTACGTACGTACGTACGTACGTACGTACGTAAATTT", "Larga");
+    CadenaADN comp("TGCATGCATGCATGCATGCATGCATGCATGCATGCATTTAAA", "Complementaria");
+    test.expectEqual(larga.getSecuencia(), string("ACGTACGTACGTACGTACGTACGTACGTACGTACGTAAATTT"), "getSecuencia decodifica la secuencia empaquetada");
+    test.expectEqual(larga.cuentaA(), 12, "cuentaA sobre varias palabras");
+    test.expectEqual(larga.proporcionGC(), 18.0 / 42, "proporcionGC con una sola pasada de composición");
+    test.check(CadenaADN("ACGTTGCAA", "").cumpleChargaff() == false && CadenaADN("ACGCGT", "").cumpleChargaff(), "cumpleChargaff desde la composición");
+    test.expectEqual(larga.contarCodon("TAC"), 8, "contarCodon con apariciones solapadas");
+    test.check(larga.esSecuenciaComplementaria(comp), "esSecuenciaComplementaria empaquetada");
+    CadenaADN mutada = larga;
+    mutada.mutar(40, 'G');
+    mutada.mutar(0, 'T');
+    test.expectEqual(larga.contarMutaciones(mutada), 2, "contarMutaciones empaquetado");
+    larga.invertir();
+    test.check(larga.getSecuencia() == comp.getSecuencia(), "invertir empaquetado");
+
+    // --- Búsqueda de subsecuencias ---
+    CadenaADN busq("GATATCGATGATATCAAAGATATC", "Busqueda");
+    test.expectEqual(busq.buscarSubsecuencia("GATATC"), 0, "buscarSubsecuencia (Shift-Or)");
+    test.expectEqual(busq.posicionUltimaAparicion("GATATC"), 18, "posicionUltimaAparicion recorriendo desde el final");
+    test.expectEqual(busq.buscarSubsecuencia("GATATX"), -1, "buscarSubsecuencia con patrón no válido");
+    vector<int> todas = busq.buscarTodas("ATC");
+    test.check(todas == vector<int>({3, 12, 21}), "buscarTodas devuelve todas las posiciones");
+    // Patrones largos: 64 bases (último caso de Shift-Or), 65 y 100 (Horspool),
+    // comparados con string::find sobre el mismo texto
+    string bloqueAzar;
+    unsigned semillaPatron = 12345;
+    for (int i = 0; i < 102; i++) {
+        semillaPatron = semillaPatron * 1103515245 + 12345;
+        bloqueAzar += "ACGT"[(semillaPatron >> 16) & 3];
+    }
+    string periodico;
+    for (int i = 0; i < 40; i++) periodico += "ACG";
+    string textoLargo = periodico + bloqueAzar + bloqueAzar;
+    CadenaADN cadenaLarga(textoLargo, "");
+    auto todasConFind = [&](const string &p) {
+        vector<int> pos;
+        for (size_t i = textoLargo.find(p); i != string::npos; i = textoLargo.find(p, i + 1)) pos.push_back(i);
+        return pos;
+    };
+    string p65Ausente = textoLargo.substr(0, 64) + "T";
+    string p100Ausente = bloqueAzar.substr(1, 100);
+    p100Ausente[50] = (p100Ausente[50] == 'A') ? 'C' : 'A';
+    vector<string> patronesLargos = {textoLargo.substr(0, 64), textoLargo.substr(0, 65), bloqueAzar.substr(1, 100),
+                                     textoLargo.substr(100, 64), p65Ausente, p100Ausente};
+    bool largosOk = true;
+    for (const string &p : patronesLargos) {
+        vector<int> esperado = todasConFind(p);
+        largosOk = largosOk && cadenaLarga.buscarTodas(p) == esperado &&
+                   cadenaLarga.buscarSubsecuencia(p) == (esperado.empty() ? -1 : esperado.front()) &&
+                   cadenaLarga.posicionUltimaAparicion(p) == (esperado.empty() ? -1 : esperado.back());
+    }
+    test.check(largosOk, "Búsquedas con patrones de 64, 65 y 100 bases coinciden con string::find");
+    test.check(cadenaLarga.buscarTodas(textoLargo.substr(0, 64)).size() == 20 && cadenaLarga.buscarTodas(textoLargo.substr(0, 65)).size() == 19,
+               "Apariciones solapadas en el límite de 64/65 bases");
+    test.check(cadenaLarga.buscarTodas(bloqueAzar.substr(1, 100)) == vector<int>({121, 223}), "Patrón de 100 bases repetido");
+    test.check(cadenaLarga.buscarSubsecuencia(p65Ausente) == -1 && cadenaLarga.posicionUltimaAparicion(p100Ausente) == -1,
+               "Patrones largos ausentes");
+
+    // --- Índice FM ---
+    CadenaADN indexada = busq;
+    indexada.construirIndice();
+    test.check(indexada.tieneIndice(), "construirIndice crea el índice");
+    test.expectEqual(indexada.contarCodon("ATC"), busq.contarCodon("ATC"), "contarCodon con índice FM");
+    test.expectEqual(indexada.posicionUltimaAparicion("GATATC"), 18, "posicionUltimaAparicion con índice FM");
+    test.check(indexada.buscarTodas("ATC") == todas, "buscarTodas con índice FM");
+    test.check(indexada.guardarIndice("prueba_indice.fm"), "guardarIndice escribe el índice");
+    CadenaADN recargada = busq;
+    test.check(recargada.cargarIndice("prueba_indice.fm") && recargada.tieneIndice(), "cargarIndice sobre una cadena igual");
+    test.check(recargada.buscarTodas("ATC") == todas && recargada.contarCodon("ATC") == 3, "Consultas con el índice cargado");
+    CadenaADN otraIndexada("ATGATG", "");
+    test.check(!otraIndexada.cargarIndice("prueba_indice.fm") && !otraIndexada.tieneIndice(), "cargarIndice rechaza otra secuencia");
+    string bytesIndice;
+    {
+        ifstream entrada("prueba_indice.fm", ios::binary);
+        bytesIndice.assign(istreambuf_iterator<char>(entrada), istreambuf_iterator<char>());
+    }
+    {
+        ofstream truncado("prueba_indice_mal.fm", ios::binary);
+        truncado << bytesIndice.substr(0, bytesIndice.size() - 5);
+    }
+    test.check(!recargada.cargarIndice("prueba_indice_mal.fm"), "cargarIndice rechaza un fichero truncado");
+    {
+        string fueraDeRango = bytesIndice;
+        fueraDeRango[28] = fueraDeRango[29] = fueraDeRango[30] = 0x7f; // Primera entrada del SA
+        ofstream corrupto("prueba_indice_mal.fm", ios::binary);
+        corrupto << fueraDeRango;
+    }
+    test.check(!recargada.cargarIndice("prueba_indice_mal.fm"), "cargarIndice rechaza un SA fuera de rango");
+    {
+        // Dos entradas del SA intercambiadas: sigue siendo una permutación
+        string intercambiado = bytesIndice;
+        for (int b = 0; b < 4; b++) swap(intercambiado[28 + 4 + b], intercambiado[28 + 8 + b]);
+        ofstream corrupto("prueba_indice_mal.fm", ios::binary);
+        corrupto << intercambiado;
+    }
+    test.check(!recargada.cargarIndice("prueba_indice_mal.fm"), "cargarIndice rechaza un SA alterado");
+    {
+        // Un símbolo de la BWT cambiado por otra base
+        string cambiado = bytesIndice;
+        size_t posBwt = 28 + 4 * (busq.getLongitud() + 1) + 3;
+        cambiado[posBwt] = (cambiado[posBwt] == 4) ? cambiado[posBwt] : (cambiado[posBwt] + 1) % 4;
+        ofstream corrupto("prueba_indice_mal.fm", ios::binary);
+        corrupto << cambiado;
+    }
+    test.check(!recargada.cargarIndice("prueba_indice_mal.fm"), "cargarIndice rechaza una BWT alterada");
+    {
+        ofstream basura("prueba_indice_mal.fm", ios::binary);
+        basura << "esto no es un índice";
+    }
+    test.check(!recargada.cargarIndice("prueba_indice_mal.fm"), "cargarIndice rechaza un fichero basura");
+    remove("prueba_indice.fm");
+    remove("prueba_indice_mal.fm");
+    indexada.mutar(0, 'C');
+    test.check(!indexada.tieneIndice(), "mutar descarta el índice");
+
+    // --- Codones como enteros de 6 bits ---
+    test.expectEqual(SecuenciaEmpaquetada::codificarCodon("ATG"), 14, "codificarCodon(ATG) = 001110");
+    test.expectEqual(SecuenciaEmpaquetada::decodificarCodon(63), string("TTT"), "decodificarCodon(63)");
+    array<int, 64> histograma = busq.histogramaCodones();
+    test.expectEqual(histograma[SecuenciaEmpaquetada::codificarCodon("ATC")], 3, "histogramaCodones cuenta codones en marco");
+    test.expectEqual(histograma[SecuenciaEmpaquetada::codificarCodon("TCG")], 0, "histogramaCodones ignora codones fuera de marco");
+
+    // --- Estadísticas en caché ---
+    CadenaADN rachas("AAACCCCGT", "Rachas");
+    test.expectEqual(rachas.longitudMaximaConsecutivaCualquiera(), 4, "Racha máxima inicial");
+    rachas.mutar(4, 'A');
+    test.expectEqual(rachas.longitudMaximaConsecutiva('C'), 2, "Racha máxima recalculada tras romperla con mutar");
+    rachas.mutar(3, 'A');
+    test.expectEqual(rachas.longitudMaximaConsecutiva('A'), 5, "Racha máxima ampliada con mutar");
+    test.expectEqual(rachas.cuentaA(), 5, "Cuentas actualizadas con mutar");
+    rachas.invertir();
+    test.expectEqual(rachas.cuentaT(), 5, "Cuentas intercambiadas al invertir");
+
+    // --- Búsqueda de varios patrones en la lista ---
+    ListaCadenasADN panel;
+    panel.insertarFinal(CadenaADN("GATATCGAATTC", "EcoRV+EcoRI"));
+    panel.insertarFinal(CadenaADN("AAAGAATTCAAA", "EcoRI"));
+    BuscadorMultiple dianas({"GATATC", "GAATTC", "AATT"});
+    vector<CoincidenciaPatron> hits = panel.buscarPatrones(dianas);
+    test.expectEqual((int)hits.size(), 5, "buscarPatrones encuentra todas las dianas");
+    test.check(hits[0].secuencia == 0 && hits[0].patron == 0 && hits[0].posicion == 0, "buscarPatrones: primera coincidencia");
+    test.check(hits[4].secuencia == 1 && hits[4].patron == 1 && hits[4].posicion == 3, "buscarPatrones: última coincidencia");
+
+    // --- Lectura de ficheros FASTA/FASTQ ---
+    {
+        ofstream fasta("prueba_lector.fa");
+        fasta << ">uno\nATGAAA\nccc\n\n>malo\nATGXAA\n>corto\nATGA\n@dos\nGGGTTT\n+\nIIIIII\n";
+    }
+    ListaCadenasADN leidas;
+    vector<ErrorLectura> erroresLectura;
+    test.expectEqual(leidas.cargarFASTA("prueba_lector.fa", erroresLectura), 2, "cargarFASTA carga los registros válidos");
+    test.expectEqual(leidas.aCadena(), string("uno:ATGAAACCC\ndos:GGGTTT"), "cargarFASTA une líneas partidas y lee FASTQ");
+    test.expectEqual((int)erroresLectura.size(), 2, "cargarFASTA informa de los registros descartados");
+    test.check(erroresLectura[0].registro == 1 && erroresLectura[0].desplazamiento == 26, "Error con el desplazamiento del carácter no válido");
+    remove("prueba_lector.fa");
+
+    // --- Instantánea binaria de la lista ---
+    ListaCadenasADN original;
+    original.insertarFinal(CadenaADN("TTTAAA", "x"));
+    original.insertarFinal(CadenaADN("ATGAAA", "a"));
+    original.insertarFinal(CadenaADN("GGGATG", "b"));
+    original.borrarPrimera(); // Deja un hueco en los identificadores
+    original.insertarFinal(CadenaADN("CCCTTT", "c"));
+    original.insertarFinal(CadenaADN("ATGAAA", "d"));
+    test.check(original.guardarInstantanea("prueba.inst"), "guardarInstantanea escribe el fichero");
+    InstantaneaADN instantanea;
+    test.check(instantanea.abrir("prueba.inst"), "InstantaneaADN abre el fichero");
+    test.expectEqual(instantanea.longitud(), original.longitud(), "Instantánea: número de registros");
+    test.expectEqual(instantanea.getCadenaADN(0).getDescripcion(), string("a"), "Instantánea: descripción del primer registro");
+    test.expectEqual(instantanea.frecuenciaCadena(CadenaADN("ATGAAA", "")), 2, "Instantánea: frecuenciaCadena");
+    test.expectEqual(instantanea.frecuenciaCodon("ATG"), original.frecuenciaCodon("ATG"), "Instantánea: frecuenciaCodon");
+    test.expectEqual(instantanea.listaCadenasConCodon("ATG"), original.listaCadenasConCodon("ATG"), "Instantánea: listaCadenasConCodon");
+    test.expectEqual(instantanea.listaCadenasADN(), original.listaCadenasADN(), "Instantánea: listaCadenasADN");
+    instantanea.cerrar();
+    {
+        // Bits a 1 más allá de la última base de una secuencia guardada
+        fstream fichero("prueba.inst", ios::in | ios::out | ios::binary);
+        uint64_t inicioPalabras = 0, primera = 0;
+        fichero.seekg(64); // Cabecera: inicio de la sección de palabras
+        fichero.read((char *)&inicioPalabras, sizeof(inicioPalabras));
+        fichero.seekg(inicioPalabras);
+        fichero.read((char *)&primera, sizeof(primera));
+        primera |= 1ULL << 63;
+        fichero.seekp(inicioPalabras);
+        fichero.write((const char *)&primera, sizeof(primera));
+    }
+    InstantaneaADN conRelleno;
+    test.check(conRelleno.abrir("prueba.inst"), "Instantánea con relleno no nulo se abre");
+    int vistasRechazadas = 0;
+    for (int i = 0; i < conRelleno.longitud(); i++) vistasRechazadas += (conRelleno.vista(i).longitud() == 0);
+    test.check(vistasRechazadas > 0 && vistasRechazadas < conRelleno.longitud(), "vista rechaza la secuencia con relleno no nulo");
+    conRelleno.cerrar();
+    remove("prueba.inst");
+    uint64_t palabraSucia = 0xFFFFFFFFFFFF0000ULL | 0x24; // "ACG" (0, 1, 2) y basura detrás
+    VistaEmpaquetada vistaSucia;
+    vistaSucia.palabras = &palabraSucia;
+    vistaSucia.n = 3;
+    CadenaADN limpia(vistaSucia, "");
+    test.check(limpia.getSecuenciaEmpaquetada() == SecuenciaEmpaquetada("ACG") && limpia.cuentaT() == 0,
+               "Construir desde una vista limpia los bits sobrantes");
+
+    // --- Movimiento y acceso sin copia ---
+    CadenaADN origen("ATGCCC", "movida");
+    CadenaADN destino(std::move(origen));
+    test.expectEqual(destino.getSecuencia(), string("ATGCCC"), "Constructor de movimiento conserva la secuencia");
+    test.check(origen.getLongitud() == 0 && origen.getDescripcion().empty(), "La cadena movida queda vacía");
+    origen = CadenaADN("GGGCCC", "reutilizada");
+    test.expectEqual(origen.getSecuencia(), string("GGGCCC"), "La cadena movida admite una asignación");
+    ListaCadenasADN movidas;
+    movidas.insertarFinal(std::move(destino));
+    movidas.emplazarFinal("GGGTTT", "emplazada");
+    IteradorLista itMov = movidas.begin();
+    test.expectEqual(itMov->getDescripcion(), string("movida"), "operator-> accede al elemento sin copiarlo");
+    itMov.step();
+    test.expectEqual((*itMov).getSecuencia(), string("GGGTTT"), "emplazarFinal añade la cadena construida");
+    ListaCadenasADN receptora(std::move(movidas));
+    test.check(receptora.longitud() == 2 && movidas.esVacia(), "Mover una lista deja la origen vacía");
+    movidas = ListaCadenasADN();
+    movidas.insertarFinal(CadenaADN("GGGAAA", ""));
+    test.check(movidas.longitud() == 1 && movidas.frecuenciaCodon("GGG") == 1, "La lista movida admite una asignación");
+    test.expectEqual(receptora.frecuenciaCodon("GGG"), 1, "La lista movida conserva sus índices");
+
+    // --- Almacén por columnas con manejadores estables ---
+    ListaCadenasADN almacen;
+    almacen.insertarFinal(CadenaADN("AAATTT", "1"));
+    almacen.insertarFinal(CadenaADN("CCCGGG", "2"));
+    IteradorLista fijo = almacen.rbegin();
+    almacen.borrarPrimera();
+    almacen.insertarInicio(CadenaADN("GGGCCC", "0"));
+    almacen.insertar(fijo, CadenaADN("TTTAAA", "1b"));
+    test.expectEqual(fijo->getDescripcion(), string("2"), "El manejador sigue válido tras insertar y borrar otros");
+    test.expectEqual(almacen.aCadena(), string("0:GGGCCC\n1b:TTTAAA\n2:CCCGGG"), "Orden conservado al insertar en medio");
+
+    // --- Agregados en paralelo ---
+    ListaCadenasADN analitica;
+    analitica.insertarFinal(CadenaADN("ACGCGT", "chargaff"));
+    analitica.insertarFinal(CadenaADN("ACGCGT", "repetida"));
+    analitica.insertarFinal(CadenaADN("AAAAAT", "racha"));
+    analitica.insertarFinal(CadenaADN("GGGCCC", "gc"));
+    test.expectEqual(analitica.contarChargaff(), 3, "contarChargaff cuenta también los duplicados");
+    test.expectEqual(analitica.rachaMaxima(), 5, "rachaMaxima de toda la lista");
+    test.check(analitica.distribucionGC(2) == vector<int>({1, 3}), "distribucionGC por intervalos");
+    test.expectEqual(analitica.usoCodones()[SecuenciaEmpaquetada::codificarCodon("ACG")], 2, "usoCodones global");
+    int bases = analitica.reducir(0, [](const RegistroLista& r) { return r.getLongitud(); },
+                                  [](int a, int b) { return a + b; });
+    test.expectEqual(bases, 24, "reducir con mapa y combinación propios");
+
+    // --- eliminaDuplicados y diferencia en bloque ---
+    ListaCadenasADN excluir;
+    excluir.insertarFinal(CadenaADN("AAAAAT", ""));
+    ListaCadenasADN restante = analitica.diferencia(excluir);
+    test.expectEqual(restante.longitud(), 3, "diferencia en bloque conserva los duplicados no excluidos");
+    test.expectEqual(restante.frecuenciaCodon("ACG"), 2, "diferencia reconstruye los índices");
+    restante.eliminaDuplicados();
+    test.expectEqual(restante.aCadena(), string("chargaff:ACGCGT\ngc:GGGCCC"), "eliminaDuplicados en paralelo conserva la primera aparición");
+    test.expectEqual(restante.frecuenciaCodon("ACG"), 1, "eliminaDuplicados reconstruye las frecuencias");
+
+    // --- Carga en bloque ---
+    vector<CadenaADN> lote = {CadenaADN("ATGAAA", "l1"), CadenaADN("ATGCCC", "l2"), CadenaADN("ATGAAA", "l3")};
+    ListaCadenasADN bloque;
+    bloque.insertarRango(lote.begin(), lote.end());
+    test.expectEqual(bloque.frecuenciaCodon("ATG"), 3, "insertarRango construye los índices al final");
+    test.expectEqual(bloque.listaCadenasConCodon("AAA"), string("ATGAAA"), "insertarRango: listas por codón");
+    {
+        SesionCarga sesion(bloque);
+        bloque.insertarFinal(CadenaADN("GGGAAA", "s1"));
+        bloque.borrarPrimera();
+        test.expectEqual(bloque.frecuenciaCodon("AAA"), 2, "Consulta durante la sesión reconstruye los índices");
+        bloque.insertarFinal(CadenaADN("GGGTTT", "s2"));
+    }
+    test.expectEqual(bloque.frecuenciaCodon("GGG"), 2, "Índices completos al cerrar la sesión");
+    test.expectEqual(bloque.frecuenciaCadena(CadenaADN("ATGAAA", "")), 1, "Frecuencias de secuencias durante la sesión");
+
+    // --- Concatenación perezosa ---
+    CuerdaADN genoma = bloque.cuerda();
+    test.expectEqual(genoma.numTrozos(), (size_t)4, "cuerda: un trozo por registro, sin copiar");
+    test.expectEqual(genoma.composicion().gc(), (size_t)11, "cuerda: composición sin materializar");
+    test.check(genoma.buscarTodas("AAAG") == vector<size_t>({9, 15}), "cuerda: búsqueda que cruza registros");
+    test.expectEqual(genoma.primera("TTTA"), -1LL, "cuerda: patrón ausente");
+    stringstream volcado;
+    genoma.escribir(volcado);
+    test.expectEqual(volcado.str(), string("ATGCCCATGAAAGGGAAAGGGTTT"), "cuerda: escritura en streaming");
+    test.expectEqual(bloque.concatenar().getSecuencia(), volcado.str(), "concatenar() desde la cuerda");
+    SecuenciaEmpaquetada trozoA("AC"), trozoB("GTA");
+    CuerdaADN partida;
+    partida.anadir(trozoA.vista());
+    partida.anadir(trozoB.vista());
+    int codonCruzado = *partida.codones().begin();
+    test.expectEqual(codonCruzado, SecuenciaEmpaquetada::codificarCodon("ACG"), "cuerda: codón repartido entre dos trozos");
+
+    // --- Matriz de mutaciones ---
+    ListaCadenasADN variantes;
+    variantes.insertarFinal(CadenaADN("ACGTAC", "v1"));
+    variantes.insertarFinal(CadenaADN("ACGTTT", "v2"));
+    variantes.insertarFinal(CadenaADN("ACG", "corta"));
+    variantes.insertarFinal(CadenaADN("ACGTAC", "v1bis"));
+    test.check(variantes.matrizMutaciones() == vector<int>({0, 2, -1, 0, 2, 0, -1, 2, -1, -1, 0, -1, 0, 2, -1, 0}),
+               "matrizMutaciones entre todos los registros");
+    test.check(variantes.matrizMutaciones(1)[1] == -1, "matrizMutaciones con umbral descarta distancias mayores");
+    test.check(variantes.mutacionesContra(CadenaADN("TCGTAC", ""), 1) == vector<int>({1, -1, -1, 1}), "mutacionesContra con umbral");
+    string larga1(3000, 'A'), larga2 = larga1;
+    larga2[5] = 'C'; larga2[2999] = 'G';
+    test.expectEqual(CadenaADN(larga1, "").contarMutaciones(CadenaADN(larga2, "")), 2, "contarMutaciones vectorizado con resto escalar");
+
+    // --- Complementaria inversa ---
+    CadenaADN hebra("ATGGAATTCCAG", "hebra");
+    CadenaADN otraHebra = hebra;
+    otraHebra.complementarInverso();
+    test.expectEqual(otraHebra.getSecuencia(), string("CTGGAATTCCAT"), "complementarInverso por palabras");
+    test.check(hebra.esComplementariaInversa(otraHebra), "esComplementariaInversa");
+    test.check(!hebra.esComplementariaInversa(hebra), "esComplementariaInversa rechaza la misma hebra");
+    test.check(CadenaADN("GAATTC", "EcoRI").esPalindromo(), "esPalindromo con diana EcoRI");
+    test.check(hebra.sitiosPalindromicos(6) == vector<int>({3}), "sitiosPalindromicos localiza GAATTC");
+
+    // --- Índice de homopolímeros ---
+    CadenaADN lectura("AAAACGTTTTTGCCCAGG", "");
+    test.expectEqual(lectura.longitudMaximaConsecutivaCualquiera(), 5, "Rachas máximas en una pasada por palabras");
+    lectura.construirIndiceRachas(3);
+    vector<Racha> largas = lectura.homopolimeros(3);
+    test.check(largas.size() == 3 && largas[1].inicio == 6 && largas[1].longitud == 5, "homopolimeros con posiciones");
+    lectura.mutar(5, 'T');
+    largas = lectura.homopolimeros(3);
+    test.check(largas.size() == 3 && largas[1].inicio == 5 && largas[1].longitud == 6, "Índice de rachas ajustado al mutar");
+    lectura.mutar(1, 'C');
+    test.expectEqual((int)lectura.homopolimeros(3).size(), 2, "mutar que rompe una racha la quita del índice");
+
+    // --- Conteo de k-mers ---
+    ListaCadenasADN lecturas;
+    lecturas.insertarFinal(CadenaADN("AAACCC", "r1"));
+    lecturas.insertarFinal(CadenaADN("GGGTTT", "r2"));
+    lecturas.insertarFinal(CadenaADN("AAACCC", "r3"));
+    ContadorKmers kmers = lecturas.contarKmers(3);
+    test.expectEqual(kmers.cuenta("AAA"), (uint64_t)3, "k-mer canónico suma las dos hebras (AAA y TTT)");
+    test.expectEqual(kmers.total(), (uint64_t)12, "Total de k-mers con duplicados");
+    test.expectEqual(lecturas.contarKmers(3, false).cuenta("TTT"), (uint64_t)1, "k-mers sin canonizar");
+    test.check(is_nothrow_move_constructible<ContadorKmers>::value, "ContadorKmers se mueve sin excepciones");
+    vector<pair<string, uint64_t> > frecuentes = lecturas.kmersFrecuentes(3, 1);
+    test.check(frecuentes.size() == 1 && frecuentes[0].first == "AAA" && frecuentes[0].second == 3, "kmersFrecuentes");
+    test.check(lecturas.histogramaKmers(3, 3) == vector<uint64_t>({0, 0, 0, 4}), "histogramaKmers");
+
+    // --- Índice MinHash ---
+    string genA, genB;
+    unsigned semilla = 12345;
+    for (int i = 0; i < 600; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        genA += "ACGT"[(semilla >> 16) & 3];
+        semilla = semilla * 1103515245u + 12345u;
+        genB += "ACGT"[(semilla >> 16) & 3];
+    }
+    string genA2 = genA;
+    genA2[100] = (genA2[100] == 'A') ? 'C' : 'A';
+    ListaCadenasADN parientes;
+    parientes.insertarFinal(CadenaADN(genB, "otra"));
+    parientes.insertarFinal(CadenaADN(genA, "original"));
+    parientes.insertarFinal(CadenaADN(genA2, "variante"));
+    parientes.insertarFinal(CadenaADN(genA.substr(0, 300), "fragmento"));
+    IndiceMinHash similitudes = parientes.indiceMinHash();
+    vector<SimilitudMinHash> cercanas = similitudes.buscar(CadenaADN(genA, ""), 0.8);
+    test.check(cercanas.size() == 2 && cercanas[0].registro == 1 && cercanas[0].similitud == 1.0 && cercanas[1].registro == 2,
+               "MinHash encuentra la secuencia y su variante");
+    test.check(similitudes.similitud(1, 0) < 0.2, "MinHash: secuencias no relacionadas");
+    test.check(similitudes.similitud(1, 3) > 0.3 && similitudes.similitud(1, 3) < 0.7, "MinHash compara longitudes distintas");
+
+    // --- Búsqueda aproximada ---
+    CadenaADN sonda("TTTGAATTCTTTGATTTCAAA", "");
+    vector<CoincidenciaAproximada> aprox = sonda.buscarAproximada("GAATTC", 1);
+    bool exacta = false, sustitucion = false;
+    for (const CoincidenciaAproximada &c : aprox) {
+        exacta |= (c.fin == 8 && c.distancia == 0);
+        sustitucion |= (c.fin == 17 && c.distancia == 1); // GATTTC
+    }
+    test.check(exacta && sustitucion && aprox.size() == 4, "buscarAproximada con errores");
+    test.check(sonda.buscarAproximada("GAATTC", 0).size() == 1, "buscarAproximada sin errores equivale a la exacta");
+    vector<CoincidenciaAproximada> enLista = variantes.buscarAproximada("ACGTTA", 1);
+    test.check(enLista.size() == 4 && enLista[0].secuencia == 0 && enLista[3].secuencia == 3, "buscarAproximada en toda la lista");
+
+    // --- Traducción y ORF ---
+    CadenaADN gen("CCATGGCTTGGTAAGCCTTACCATCCA", "");
+    test.expectEqual(gen.traducir(3), string("MAW*ALPS"), "traducir con la tabla de 64 codones");
+    test.expectEqual(CadenaADN("ATGTAA", "").traducir(-1), string("LH"), "traducir en la hebra inversa");
+    vector<MarcoAbierto> orfs = gen.buscarORFs(2);
+    test.check(orfs.size() == 1 && orfs[0].marco == 3 && orfs[0].inicio == 2 && orfs[0].fin == 14 && orfs[0].aminoacidos() == 3,
+               "buscarORFs en la hebra directa");
+    vector<MarcoAbierto> orfsInversos = CadenaADN("TTACATCAT", "").buscarORFs(1);
+    test.check(orfsInversos.size() == 1 && orfsInversos[0].marco == -1 && orfsInversos[0].inicio == 0 && orfsInversos[0].fin == 9,
+               "buscarORFs en la hebra inversa");
+    ListaCadenasADN genes;
+    genes.insertarFinal(CadenaADN("ATGCCCTGA", "g1"));
+    genes.insertarFinal(CadenaADN("GGGGGG", "g2"));
+    genes.insertarFinal(CadenaADN("ATGCCCTGA", "g3"));
+    vector<MarcoAbierto> orfsLista = genes.buscarORFs(1);
+    test.check(orfsLista.size() == 2 && orfsLista[0].secuencia == 0 && orfsLista[1].secuencia == 2, "buscarORFs en toda la lista");
+
+    // --- Validación vectorial ---
+    string textoBases(70, 'G');
+    test.expectEqual(SecuenciaEmpaquetada::primeraNoValida(textoBases.data(), textoBases.size()), -1LL, "primeraNoValida sin errores");
+    textoBases[45] = 'a';
+    textoBases[60] = 'N';
+    test.expectEqual(SecuenciaEmpaquetada::primeraNoValida(textoBases.data(), textoBases.size()), 45LL, "primeraNoValida da el primer carácter no válido");
+    test.expectEqual(SecuenciaEmpaquetada::primeraNoValida(textoBases.data() + 46, 24), 14LL, "primeraNoValida en el resto sin bloque completo");
+    test.check(!CadenaADN().validador(string(47, 'C') + "X", ""), "validador rechaza un carácter tras varios bloques");
+    CadenaADN adoptada(SecuenciaEmpaquetada("ATGCCC"), "adoptada");
+    test.check(adoptada.getSecuencia() == "ATGCCC" && adoptada.getDescripcion() == "adoptada", "Constructor que adopta una secuencia empaquetada");
+
     test.summary();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include "IndiceFM.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+static const char MAGICO_FM[8] = {'G', 'E', 'N', 'O', 'M', 'A', 'F', 'M'};
+static const uint32_t VERSION_FM = 1;
+
+// =============================================
+// CONSTRUCCIÓN
+// =============================================
+
+IndiceFM::IndiceFM() {}
+
+IndiceFM::IndiceFM(const VistaEmpaquetada &v) {
+    construir(v);
+}
+
+// Resumen de 64 bits de las palabras empaquetadas y la longitud
+uint64_t IndiceFM::calcularResumen(const VistaEmpaquetada &v) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ v.longitud();
+    for (size_t w = 0; w < v.numPalabras(); w++) {
+        h ^= v.palabras[w];
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+    }
+    return h;
+}
+
+// Array de sufijos por duplicación de prefijos con ordenación por cuentas,
+// O(n log n). Como $ es único y el menor, ordenar las rotaciones de texto$
+// equivale a ordenar sus sufijos.
+void IndiceFM::construir(const VistaEmpaquetada &v) {
+    n = v.longitud();
+    resumen = calcularResumen(v);
+    size_t total = n + 1;
+
+    // Texto con $ = 0 y las bases desplazadas a 1..4
+    vector<int> texto(total);
+    for (size_t i = 0; i < n; i++) {
+        texto[i] = v.codigo(i) + 1;
+    }
+    texto[n] = 0;
+
+    vector<int> &sa = sufijos;
+    sa.assign(total, 0);
+    vector<int> clase(total), saNuevo(total), claseNueva(total);
+    vector<int> cuenta(max(total, (size_t)5), 0);
+
+    for (size_t i = 0; i < total; i++) cuenta[texto[i]]++;
+    for (size_t c = 1; c < 5; c++) cuenta[c] += cuenta[c - 1];
+    for (size_t i = total; i > 0; i--) sa[--cuenta[texto[i - 1]]] = i - 1;
+
+    int clases = 1;
+    clase[sa[0]] = 0;
+    for (size_t i = 1; i < total; i++) {
+        if (texto[sa[i]] != texto[sa[i - 1]]) clases++;
+        clase[sa[i]] = clases - 1;
+    }
+
+    for (size_t h = 1; h < total && (size_t)clases < total; h <<= 1) {
+        // Ordenar por la segunda mitad ya viene dado por sa desplazado h posiciones
+        for (size_t i = 0; i < total; i++) {
+            saNuevo[i] = (sa[i] + total - h) % total;
+        }
+        fill(cuenta.begin(), cuenta.begin() + clases, 0);
+        for (size_t i = 0; i < total; i++) cuenta[clase[saNuevo[i]]]++;
+        for (int c = 1; c < clases; c++) cuenta[c] += cuenta[c - 1];
+        for (size_t i = total; i > 0; i--) sa[--cuenta[clase[saNuevo[i - 1]]]] = saNuevo[i - 1];
+
+        claseNueva[sa[0]] = 0;
+        clases = 1;
+        for (size_t i = 1; i < total; i++) {
+            int a1 = clase[sa[i]], a2 = clase[(sa[i] + h) % total];
+            int b1 = clase[sa[i - 1]], b2 = clase[(sa[i - 1] + h) % total];
+            if (a1 != b1 || a2 != b2) clases++;
+            claseNueva[sa[i]] = clases - 1;
+        }
+        clase.swap(claseNueva);
+    }
+
+    // BWT: símbolo anterior a cada sufijo
+    bwt.assign(total, 4);
+    for (size_t i = 0; i < total; i++) {
+        if (sa[i] > 0) {
+            bwt[i] = texto[sa[i] - 1] - 1;
+        }
+    }
+
+    construirAuxiliares();
+}
+
+// Tabla C, marcas de rango cada BLOQUE símbolos y árboles de mínimos/máximos
+void IndiceFM::construirAuxiliares() {
+    size_t total = n + 1;
+
+    size_t cuentas[4] = {0, 0, 0, 0};
+    marcas.assign(4 * (total / BLOQUE + 1), 0);
+    for (size_t i = 0; i <= total; i++) {
+        if (i % BLOQUE == 0) {
+            for (int c = 0; c < 4; c++) marcas[4 * (i / BLOQUE) + c] = cuentas[c];
+        }
+        if (i < total && bwt[i] < 4) cuentas[bwt[i]]++;
+    }
+
+    acumulado[0] = 1; // El $
+    for (int c = 1; c < 5; c++) {
+        acumulado[c] = acumulado[c - 1] + cuentas[c - 1];
+    }
+
+    minimos.assign(2 * total, INT_MAX);
+    maximos.assign(2 * total, -1);
+    for (size_t i = 0; i < total; i++) {
+        minimos[total + i] = maximos[total + i] = sufijos[i];
+    }
+    for (size_t i = total - 1; i > 0; i--) {
+        minimos[i] = min(minimos[2 * i], minimos[2 * i + 1]);
+        maximos[i] = max(maximos[2 * i], maximos[2 * i + 1]);
+    }
+}
+
+// =============================================
+// CONSULTAS
+// =============================================
+
+size_t IndiceFM::longitudTexto() const {
+    return n;
+}
+
+// Además del resumen, comprueba en O(n) el SA y la BWT contra el texto:
+//  - bwt[i] es la base anterior al sufijo sa[i] ($ para el sufijo 0);
+//  - la correspondencia LF: entre los sufijos precedidos por la base c, el
+//    orden del SA es el de sus sufijos extendidos por c. Junto con la tabla C,
+//    eso solo se cumple si el SA es el orden lexicográfico de los sufijos.
+bool IndiceFM::correspondeA(const VistaEmpaquetada &v) const {
+    if (v.longitud() != n || calcularResumen(v) != resumen || sufijos.size() != n + 1 || bwt.size() != n + 1) {
+        return false;
+    }
+    vector<int> inverso(n + 1);
+    for (size_t i = 0; i <= n; i++) {
+        inverso[sufijos[i]] = i;
+    }
+    if (inverso[n] != 0) {
+        return false; // El sufijo "$" es el menor
+    }
+    size_t vistos[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i <= n; i++) {
+        if (sufijos[i] == 0) {
+            if (bwt[i] != 4) {
+                return false;
+            }
+            continue;
+        }
+        int c = v.codigo(sufijos[i] - 1);
+        if (bwt[i] != c || (size_t)inverso[sufijos[i] - 1] != acumulado[c] + vistos[c]) {
+            return false;
+        }
+        vistos[c]++;
+    }
+    return true;
+}
+
+// Apariciones de la base c en bwt[0, i)
+size_t IndiceFM::rango(int c, size_t i) const {
+    size_t bloque = i / BLOQUE;
+    size_t r = marcas[4 * bloque + c];
+    for (size_t k = bloque * BLOQUE; k < i; k++) {
+        r += (bwt[k] == c);
+    }
+    return r;
+}
+
+// Búsqueda hacia atrás: intervalo [ini, fin) del SA con los sufijos que
+// empiezan por el patrón. Devuelve false si no aparece.
+bool IndiceFM::intervalo(const string &patron, size_t &ini, size_t &fin) const {
+    if (patron.empty() || sufijos.empty()) {
+        return false;
+    }
+    ini = 0;
+    fin = n + 1;
+    for (size_t j = patron.length(); j > 0 && ini < fin; j--) {
+        int c = SecuenciaEmpaquetada::codificar(patron[j - 1]);
+        if (c < 0) {
+            return false;
+        }
+        ini = acumulado[c] + rango(c, ini);
+        fin = acumulado[c] + rango(c, fin);
+    }
+    return ini < fin;
+}
+
+int IndiceFM::contar(const string &patron) const {
+    size_t ini, fin;
+    return intervalo(patron, ini, fin) ? (int)(fin - ini) : 0;
+}
+
+int IndiceFM::primera(const string &patron) const {
+    size_t ini, fin;
+    if (!intervalo(patron, ini, fin)) {
+        return -1;
+    }
+    int minimo = INT_MAX;
+    size_t total = n + 1;
+    for (ini += total, fin += total; ini < fin; ini >>= 1, fin >>= 1) {
+        if (ini & 1) minimo = min(minimo, minimos[ini++]);
+        if (fin & 1) minimo = min(minimo, minimos[--fin]);
+    }
+    return minimo;
+}
+
+int IndiceFM::ultima(const string &patron) const {
+    size_t ini, fin;
+    if (!intervalo(patron, ini, fin)) {
+        return -1;
+    }
+    int maximo = -1;
+    size_t total = n + 1;
+    for (ini += total, fin += total; ini < fin; ini >>= 1, fin >>= 1) {
+        if (ini & 1) maximo = max(maximo, maximos[ini++]);
+        if (fin & 1) maximo = max(maximo, maximos[--fin]);
+    }
+    return maximo;
+}
+
+vector<int> IndiceFM::todas(const string &patron) const {
+    vector<int> posiciones;
+    size_t ini, fin;
+    if (intervalo(patron, ini, fin)) {
+        posiciones.assign(sufijos.begin() + ini, sufijos.begin() + fin);
+        sort(posiciones.begin(), posiciones.end());
+    }
+    return posiciones;
+}
+
+// =============================================
+// ALMACENAJE Y LECTURA DE FICHEROS
+// =============================================
+
+// Guarda el índice en binario: cabecera, array de sufijos y BWT.
+// Las tablas auxiliares se reconstruyen al cargar en O(n).
+bool IndiceFM::guardarEnFichero(const string &path) const {
+    ofstream fichero(path, ios::binary);
+    if (!fichero.is_open()) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+    uint64_t longitud = n;
+    fichero.write(MAGICO_FM, sizeof(MAGICO_FM));
+    fichero.write((const char *)&VERSION_FM, sizeof(VERSION_FM));
+    fichero.write((const char *)&longitud, sizeof(longitud));
+    fichero.write((const char *)&resumen, sizeof(resumen));
+    fichero.write((const char *)sufijos.data(), sufijos.size() * sizeof(int));
+    fichero.write((const char *)bwt.data(), bwt.size());
+    return fichero.good();
+}
+
+bool IndiceFM::cargarDesdeFichero(const string &path, long long longitudEsperada) {
+    ifstream fichero(path, ios::binary);
+    if (!fichero.is_open()) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+    char magico[8];
+    uint32_t version = 0;
+    uint64_t longitud = 0, res = 0;
+    fichero.read(magico, sizeof(magico));
+    fichero.read((char *)&version, sizeof(version));
+    fichero.read((char *)&longitud, sizeof(longitud));
+    fichero.read((char *)&res, sizeof(res));
+    if (!fichero || !equal(magico, magico + 8, MAGICO_FM) || version != VERSION_FM) {
+        cout << "Error: el archivo no es un índice FM válido.\n";
+        return false;
+    }
+
+    // Antes de reservar memoria: la longitud debe caber en el array de
+    // sufijos y el resto del fichero debe tener exactamente su tamaño
+    streamoff cabecera = fichero.tellg();
+    fichero.seekg(0, ios::end);
+    streamoff restante = fichero.tellg() - cabecera;
+    fichero.seekg(cabecera);
+    if (longitud >= (uint64_t)INT_MAX ||
+        (longitudEsperada >= 0 && longitud != (uint64_t)longitudEsperada) ||
+        (uint64_t)restante != (longitud + 1) * (sizeof(int) + 1)) {
+        cout << "Error: el índice FM está incompleto o no corresponde.\n";
+        return false;
+    }
+
+    vector<int> sa(longitud + 1);
+    vector<uint8_t> b(longitud + 1);
+    fichero.read((char *)sa.data(), sa.size() * sizeof(int));
+    fichero.read((char *)b.data(), b.size());
+    if (!fichero) {
+        cout << "Error: el índice FM está incompleto.\n";
+        return false;
+    }
+
+    // El SA debe ser una permutación de 0..n y la BWT tener un solo $
+    vector<bool> visto(longitud + 1, false);
+    size_t dolares = 0;
+    for (size_t i = 0; i <= longitud; i++) {
+        if (sa[i] < 0 || (uint64_t)sa[i] > longitud || visto[sa[i]] || b[i] > 4) {
+            cout << "Error: el índice FM tiene valores fuera de rango.\n";
+            return false;
+        }
+        visto[sa[i]] = true;
+        dolares += (b[i] == 4);
+    }
+    if (dolares != 1) {
+        cout << "Error: el índice FM tiene valores fuera de rango.\n";
+        return false;
+    }
+
+    n = longitud;
+    resumen = res;
+    sufijos.swap(sa);
+    bwt.swap(b);
+    construirAuxiliares();
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef INDICEFM_H
+#define INDICEFM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Índice de texto completo (array de sufijos + BWT / índice FM) sobre el
+// alfabeto A, C, G, T. Se construye explícitamente una vez y responde a
+// consultas de un patrón de longitud m:
+//  - contar: O(m)
+//  - primera / ultima: O(m + log n) (árboles de mínimos y máximos sobre el SA)
+//  - todas: O(m + occ log occ) para occ apariciones (se ordenan)
+class IndiceFM {
+    private:
+    size_t n = 0;                  // Longitud del texto (sin el terminador $)
+    uint64_t resumen = 0;          // Resumen del texto para comprobar que corresponde
+    vector<int> sufijos;           // Array de sufijos de texto$ (n + 1 entradas)
+    vector<uint8_t> bwt;           // Transformada de Burrows-Wheeler (4 = $)
+    size_t acumulado[5] = {0, 0, 0, 0, 0}; // Símbolos menores que cada base (incluye $)
+    vector<uint32_t> marcas;       // Apariciones de cada base antes de cada bloque
+    vector<int> minimos, maximos;  // Árboles de segmentos sobre el SA
+
+    static const size_t BLOQUE = 64;
+
+    static uint64_t calcularResumen(const VistaEmpaquetada &);
+    void construirAuxiliares();
+    size_t rango(int, size_t) const;
+    bool intervalo(const string &, size_t &, size_t &) const;
+    public:
+    IndiceFM();
+    IndiceFM(const VistaEmpaquetada &);
+
+    void construir(const VistaEmpaquetada &);
+    size_t longitudTexto() const;
+    // Comprueba que el índice se construyó sobre esta secuencia: el resumen
+    // y, en O(n), que el SA y la BWT son los de ese texto
+    bool correspondeA(const VistaEmpaquetada &) const;
+
+    int contar(const string &) const;
+    int primera(const string &) const;   // -1 si no aparece
+    int ultima(const string &) const;    // -1 si no aparece
+    vector<int> todas(const string &) const; // Posiciones en orden creciente
+
+    // Formato binario propio (array de sufijos y BWT). Al cargar se
+    // rechaza el fichero si su tamaño no cuadra con la longitud de la
+    // cabecera, si esta no es 'longitudEsperada' (-1: cualquiera) o si el
+    // array de sufijos o la BWT tienen valores fuera de rango
+    bool guardarEnFichero(const string &) const;
+    bool cargarDesdeFichero(const string &, long long longitudEsperada = -1);
+};
+
+#endif // INDICEFM_H
@@ -0,0 +1,158 @@
+#include "IndiceMinHash.h"
+#include "Paralelo.h"
+#include <algorithm>
+using namespace std;
+
+static inline uint64_t mezclar(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+IndiceMinHash::IndiceMinHash(int ik, int ibandas, int ifilas) : k(ik), bandas(ibandas), filas(ifilas) {
+    if (!esValido()) {
+        return;
+    }
+    for (int i = 0; i < bandas * filas; i++) {
+        semillas.push_back(mezclar(0x9e3779b97f4a7c15ULL * (i + 1)));
+    }
+    cubetas.resize(bandas);
+}
+
+bool IndiceMinHash::esValido() const {
+    return k >= 1 && k <= 31 && bandas >= 1 && filas >= 1;
+}
+
+size_t IndiceMinHash::numEntradas() const {
+    return firmaDeEntrada.size();
+}
+
+size_t IndiceMinHash::tamFirma() const {
+    return semillas.size();
+}
+
+// k-mers canónicos (el menor de las dos hebras), como en ContadorKmers
+vector<uint64_t> IndiceMinHash::firma(const VistaEmpaquetada &v) const {
+    vector<uint64_t> minimos;
+    if (!esValido() || v.longitud() < (size_t)k) {
+        return minimos;
+    }
+    minimos.assign(semillas.size(), ~0ULL);
+    const uint64_t mascara = (1ULL << (2 * k)) - 1;
+    const int desp = 2 * (k - 1);
+    uint64_t directo = 0, inverso = 0;
+    for (size_t i = 0; i < v.longitud(); i++) {
+        uint64_t c = v.codigo(i);
+        directo = ((directo << 2) | c) & mascara;
+        inverso = (inverso >> 2) | ((3 - c) << desp);
+        if (i + 1 < (size_t)k) {
+            continue;
+        }
+        uint64_t kmer = min(directo, inverso);
+        for (size_t h = 0; h < semillas.size(); h++) {
+            minimos[h] = min(minimos[h], mezclar(kmer ^ semillas[h]));
+        }
+    }
+    return minimos;
+}
+
+uint64_t IndiceMinHash::resumenBanda(const vector<uint64_t> &f, int banda) const {
+    uint64_t h = banda;
+    for (int j = 0; j < filas; j++) {
+        h = mezclar(h ^ f[banda * filas + j]);
+    }
+    return h;
+}
+
+// Las firmas vacías no se indexan: no tienen k-mers que comparar
+void IndiceMinHash::indexar(int entrada) {
+    const vector<uint64_t> &f = firmas[firmaDeEntrada[entrada]];
+    if (f.empty()) {
+        return;
+    }
+    for (int b = 0; b < bandas; b++) {
+        cubetas[b][resumenBanda(f, b)].push_back(entrada);
+    }
+}
+
+int IndiceMinHash::anadir(const VistaEmpaquetada &v) {
+    firmas.push_back(firma(v));
+    firmaDeEntrada.push_back(firmas.size() - 1);
+    indexar(firmaDeEntrada.size() - 1);
+    return firmaDeEntrada.size() - 1;
+}
+
+void IndiceMinHash::anadirEnBloque(const vector<VistaEmpaquetada> &secuencias, const vector<int> &entradas) {
+    size_t base = firmas.size();
+    firmas.resize(base + secuencias.size());
+    paraleloPorBloques(secuencias.size(), 16, [&](size_t ini, size_t fin) {
+        for (size_t s = ini; s < fin; s++) {
+            firmas[base + s] = firma(secuencias[s]);
+        }
+    });
+    for (int s : entradas) {
+        firmaDeEntrada.push_back(base + s);
+        indexar(firmaDeEntrada.size() - 1);
+    }
+}
+
+static double fraccionIguales(const vector<uint64_t> &a, const vector<uint64_t> &b) {
+    if (a.empty() || b.empty()) {
+        return 0.0;
+    }
+    size_t iguales = 0;
+    for (size_t h = 0; h < a.size(); h++) {
+        iguales += (a[h] == b[h]);
+    }
+    return (double)iguales / a.size();
+}
+
+double IndiceMinHash::similitud(int a, int b) const {
+    if (a < 0 || b < 0 || a >= (int)numEntradas() || b >= (int)numEntradas()) {
+        return 0.0;
+    }
+    return fraccionIguales(firmas[firmaDeEntrada[a]], firmas[firmaDeEntrada[b]]);
+}
+
+// Solo se comparan las entradas de las cubetas de la consulta; cada firma
+// distinta se compara una vez aunque la compartan varias entradas
+vector<SimilitudMinHash> IndiceMinHash::buscar(const VistaEmpaquetada &v, double umbral) const {
+    vector<SimilitudMinHash> resultado;
+    vector<uint64_t> f = firma(v);
+    if (f.empty()) {
+        return resultado;
+    }
+    vector<int> candidatas;
+    for (int b = 0; b < bandas; b++) {
+        auto it = cubetas[b].find(resumenBanda(f, b));
+        if (it != cubetas[b].end()) {
+            candidatas.insert(candidatas.end(), it->second.begin(), it->second.end());
+        }
+    }
+    sort(candidatas.begin(), candidatas.end());
+    candidatas.erase(unique(candidatas.begin(), candidatas.end()), candidatas.end());
+
+    unordered_map<int, double> porFirma;
+    for (int e : candidatas) {
+        int id = firmaDeEntrada[e];
+        auto it = porFirma.find(id);
+        double s = (it != porFirma.end()) ? it->second : (porFirma[id] = fraccionIguales(f, firmas[id]));
+        if (s >= umbral) {
+            SimilitudMinHash r;
+            r.registro = e;
+            r.similitud = s;
+            resultado.push_back(r);
+        }
+    }
+    stable_sort(resultado.begin(), resultado.end(), [](const SimilitudMinHash &a, const SimilitudMinHash &b) {
+        return a.similitud > b.similitud;
+    });
+    return resultado;
+}
+
+vector<SimilitudMinHash> IndiceMinHash::buscar(const CadenaADN &c, double umbral) const {
+    return buscar(c.getSecuenciaEmpaquetada().vista(), umbral);
+}
@@ -0,0 +1,58 @@
+#ifndef INDICEMINHASH_H
+#define INDICEMINHASH_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+#include "CadenaADN.h"
+
+using namespace std;
+
+// Entrada parecida a la consulta y su similitud de Jaccard estimada
+struct SimilitudMinHash {
+    int registro;
+    double similitud;
+};
+
+// Índice de similitud entre secuencias de cualquier longitud. Cada entrada
+// se resume en una firma MinHash: para cada una de bandas*filas funciones
+// hash, el mínimo sobre sus k-mers canónicos. La fracción de mínimos iguales
+// entre dos firmas estima la similitud de Jaccard de sus conjuntos de k-mers.
+// Para no comparar la consulta con todas las entradas (LSH), la firma se
+// parte en bandas de 'filas' mínimos y solo se comparan las entradas que
+// coinciden con la consulta en alguna banda entera. Dos secuencias con
+// similitud s son candidatas con probabilidad 1 - (1 - s^filas)^bandas.
+class IndiceMinHash {
+    private:
+    int k, bandas, filas;
+    vector<uint64_t> semillas;
+    vector<vector<uint64_t> > firmas;   // Firmas distintas añadidas
+    vector<int> firmaDeEntrada;         // Entrada -> firma
+    vector<unordered_map<uint64_t, vector<int> > > cubetas; // Por banda: resumen -> entradas
+
+    uint64_t resumenBanda(const vector<uint64_t> &, int banda) const;
+    void indexar(int entrada);
+    public:
+    IndiceMinHash(int k = 16, int bandas = 16, int filas = 4);
+
+    bool esValido() const;
+    size_t numEntradas() const;
+    size_t tamFirma() const;
+
+    // Firma de una secuencia; vacía si tiene menos de k bases
+    vector<uint64_t> firma(const VistaEmpaquetada &) const;
+    // Añade una entrada y devuelve su número (consecutivos desde 0)
+    int anadir(const VistaEmpaquetada &);
+    // Añade una entrada por cada elemento de 'entradas', con la firma de
+    // secuencias[entradas[i]]; las firmas se calculan una vez y en paralelo
+    void anadirEnBloque(const vector<VistaEmpaquetada> &secuencias, const vector<int> &entradas);
+
+    // Similitud estimada entre dos entradas
+    double similitud(int, int) const;
+    // Entradas con similitud estimada >= umbral, de mayor a menor similitud
+    vector<SimilitudMinHash> buscar(const VistaEmpaquetada &, double umbral) const;
+    vector<SimilitudMinHash> buscar(const CadenaADN &, double umbral) const;
+};
+
+#endif // INDICEMINHASH_H
@@ -0,0 +1,346 @@
+#include "InstantaneaADN.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+static const char MAGICO_INSTANTANEA[8] = {'G', 'E', 'N', 'O', 'M', 'A', 'L', 'S'};
+static const uint32_t VERSION_INSTANTANEA = 1;
+static const int ENTRADAS_CODONES = 64 + 65; // Frecuencias y comienzos CSR
+static const uint32_t VACIO = 0xFFFFFFFF;     // Hueco libre en la tabla por huella
+
+InstantaneaADN::InstantaneaADN() {}
+
+InstantaneaADN::~InstantaneaADN() {
+    cerrar();
+}
+
+// =============================================
+// ESCRITURA
+// =============================================
+
+// Los identificadores del pool pueden tener huecos: en la instantánea se
+// renumeran de forma densa por orden de primera aparición en la lista
+bool InstantaneaADN::guardar(const ListaCadenasADN &lista, const string &path) {
+    ofstream fichero(path, ios::binary);
+    if (!fichero.is_open()) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+
+    lista.asegurarIndices();
+    const PoolSecuencias &pool = lista.secuencias;
+    vector<int> denso(pool.capacidad(), -1);
+    vector<int> orden; // Identificador del pool de cada secuencia densa
+    vector<Registro> registros;
+    string descripciones;
+    for (int reg = lista.siguiente[0]; reg != 0; reg = lista.siguiente[reg]) {
+        int id = lista.secuenciaRegistro[reg];
+        if (denso[id] < 0) {
+            denso[id] = orden.size();
+            orden.push_back(id);
+        }
+        Registro r;
+        r.secuencia = denso[id];
+        r.longDescripcion = lista.longDescripcion[reg];
+        r.descripcion = descripciones.size();
+        registros.push_back(r);
+        descripciones.append(lista.descripciones, lista.inicioDescripcion[reg], lista.longDescripcion[reg]);
+    }
+
+    vector<Secuencia> secuencias(orden.size());
+    vector<uint64_t> palabras;
+    for (size_t d = 0; d < orden.size(); d++) {
+        VistaEmpaquetada v = pool.vista(orden[d]);
+        const Huella &h = pool.huella(orden[d]);
+        secuencias[d].palabra = palabras.size();
+        secuencias[d].n = v.longitud();
+        secuencias[d].referencias = pool.referencias(orden[d]);
+        secuencias[d].alta = h.alta;
+        secuencias[d].baja = h.baja;
+        palabras.insert(palabras.end(), v.palabras, v.palabras + v.numPalabras());
+    }
+
+    // Tabla de direccionamiento abierto con ocupación <= 1/2
+    uint64_t tamTabla = 2;
+    while (tamTabla < 2 * orden.size()) {
+        tamTabla <<= 1;
+    }
+    vector<uint32_t> tabla(tamTabla, VACIO);
+    for (size_t d = 0; d < orden.size(); d++) {
+        uint64_t pos = secuencias[d].baja & (tamTabla - 1);
+        while (tabla[pos] != VACIO) {
+            pos = (pos + 1) & (tamTabla - 1);
+        }
+        tabla[pos] = d;
+    }
+
+    vector<uint64_t> codones(ENTRADAS_CODONES, 0);
+    vector<uint32_t> postings;
+    for (int cod = 0; cod < 64; cod++) {
+        codones[cod] = lista.frecCodones[cod];
+        codones[64 + cod] = postings.size();
+        size_t desde = postings.size();
+        for (int id : lista.secuenciasConCodon[cod]) {
+            postings.push_back(denso[id]);
+        }
+        sort(postings.begin() + desde, postings.end());
+    }
+    codones[64 + 64] = postings.size();
+
+    Cabecera cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magico, MAGICO_INSTANTANEA, sizeof(cab.magico));
+    cab.version = VERSION_INSTANTANEA;
+    cab.numRegistros = registros.size();
+    cab.numSecuencias = orden.size();
+    cab.tamTabla = tamTabla;
+
+    const void *datos[NUM_SECCIONES] = {registros.data(), descripciones.data(), secuencias.data(),
+                                        palabras.data(), tabla.data(), codones.data(), postings.data()};
+    uint64_t bytes[NUM_SECCIONES] = {registros.size() * sizeof(Registro), descripciones.size(),
+                                     secuencias.size() * sizeof(Secuencia), palabras.size() * sizeof(uint64_t),
+                                     tabla.size() * sizeof(uint32_t), codones.size() * sizeof(uint64_t),
+                                     postings.size() * sizeof(uint32_t)};
+    uint64_t pos = sizeof(Cabecera);
+    for (int s = 0; s < NUM_SECCIONES; s++) {
+        cab.inicio[s] = pos;
+        cab.bytes[s] = bytes[s];
+        pos = (pos + bytes[s] + 7) & ~(uint64_t)7;
+    }
+
+    static const char relleno[8] = {0};
+    fichero.write((const char *)&cab, sizeof(cab));
+    for (int s = 0; s < NUM_SECCIONES; s++) {
+        fichero.write((const char *)datos[s], bytes[s]);
+        fichero.write(relleno, (8 - bytes[s] % 8) % 8);
+    }
+    return fichero.good();
+}
+
+// =============================================
+// APERTURA
+// =============================================
+
+// Solo se leen la cabecera y la tabla de secciones: el resto del fichero
+// no se toca hasta que lo pide una consulta
+bool InstantaneaADN::abrir(const string &path) {
+    cerrar();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Cabecera)) {
+        close(fd);
+        cout << "Error: el archivo no es una instantánea válida.\n";
+        return false;
+    }
+    void *mapa = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+    base = (const char *)mapa;
+    tam = info.st_size;
+
+    const Cabecera &cab = cabecera();
+    bool valida = memcmp(cab.magico, MAGICO_INSTANTANEA, sizeof(cab.magico)) == 0 &&
+                  cab.version == VERSION_INSTANTANEA && cab.numRegistros <= 0x7FFFFFFF &&
+                  cab.numSecuencias < VACIO && cab.tamTabla > cab.numSecuencias &&
+                  (cab.tamTabla & (cab.tamTabla - 1)) == 0;
+    for (int s = 0; valida && s < NUM_SECCIONES; s++) {
+        valida = cab.inicio[s] % 8 == 0 && cab.inicio[s] <= tam && cab.bytes[s] <= tam - cab.inicio[s];
+    }
+    valida = valida && cab.bytes[REGISTROS] / sizeof(Registro) >= cab.numRegistros &&
+             cab.bytes[SECUENCIAS] / sizeof(Secuencia) >= cab.numSecuencias &&
+             cab.bytes[TABLA] / sizeof(uint32_t) >= cab.tamTabla &&
+             cab.bytes[CODONES] >= ENTRADAS_CODONES * sizeof(uint64_t);
+    if (valida) {
+        const uint64_t *csr = (const uint64_t *)seccion(CODONES) + 64;
+        valida = cab.bytes[POSTINGS] / sizeof(uint32_t) >= csr[64];
+        for (int cod = 0; valida && cod < 64; cod++) {
+            valida = csr[cod] <= csr[cod + 1];
+        }
+    }
+    if (!valida) {
+        cerrar();
+        cout << "Error: el archivo no es una instantánea válida.\n";
+        return false;
+    }
+    return true;
+}
+
+void InstantaneaADN::cerrar() {
+    if (base != nullptr) {
+        munmap((void *)base, tam);
+    }
+    base = nullptr;
+    tam = 0;
+}
+
+bool InstantaneaADN::estaAbierta() const {
+    return base != nullptr;
+}
+
+// =============================================
+// ACCESO A LAS SECCIONES
+// =============================================
+
+const InstantaneaADN::Cabecera &InstantaneaADN::cabecera() const {
+    return *(const Cabecera *)base;
+}
+
+const char *InstantaneaADN::seccion(Seccion s) const {
+    return base + cabecera().inicio[s];
+}
+
+const InstantaneaADN::Registro &InstantaneaADN::registro(int i) const {
+    return ((const Registro *)seccion(REGISTROS))[i];
+}
+
+const InstantaneaADN::Secuencia &InstantaneaADN::secuencia(int id) const {
+    return ((const Secuencia *)seccion(SECUENCIAS))[id];
+}
+
+// Vista vacía si la secuencia se sale de la sección de palabras o si su
+// última palabra tiene bits a 1 más allá del final (fichero corrupto):
+// igual, huella y los recuentos suponen que esos bits son cero
+VistaEmpaquetada InstantaneaADN::vistaSecuencia(int id) const {
+    VistaEmpaquetada v;
+    if (id < 0 || (uint64_t)id >= cabecera().numSecuencias) {
+        return v;
+    }
+    const Secuencia &s = secuencia(id);
+    uint64_t total = cabecera().bytes[PALABRAS] / sizeof(uint64_t);
+    uint64_t usadas = (s.n + VistaEmpaquetada::BASES_POR_PALABRA - 1) / VistaEmpaquetada::BASES_POR_PALABRA;
+    if (s.palabra > total || usadas > total - s.palabra) {
+        return v;
+    }
+    v.palabras = (const uint64_t *)seccion(PALABRAS) + s.palabra;
+    v.n = s.n;
+    if (usadas > 0 && (v.palabras[usadas - 1] & ~v.mascaraUltima()) != 0) {
+        return VistaEmpaquetada();
+    }
+    return v;
+}
+
+int InstantaneaADN::buscarSecuencia(const VistaEmpaquetada &v) const {
+    Huella h = v.huella();
+    const uint32_t *tabla = (const uint32_t *)seccion(TABLA);
+    uint64_t mascara = cabecera().tamTabla - 1;
+    uint64_t pos = h.baja & mascara;
+    for (uint64_t k = 0; k <= mascara && tabla[pos] != VACIO; k++, pos = (pos + 1) & mascara) {
+        int id = tabla[pos];
+        if ((uint64_t)id >= cabecera().numSecuencias) {
+            return -1;
+        }
+        const Secuencia &s = secuencia(id);
+        if (s.alta == h.alta && s.baja == h.baja && vistaSecuencia(id).igual(v)) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+string InstantaneaADN::unirOrdenadas(vector<string> &seqs) const {
+    sort(seqs.begin(), seqs.end());
+    string res = "";
+    for (const string &seq : seqs) {
+        res += (res == "" ? "" : "\n") + seq;
+    }
+    return res;
+}
+
+// =============================================
+// CONSULTAS
+// =============================================
+
+int InstantaneaADN::longitud() const {
+    return estaAbierta() ? (int)cabecera().numRegistros : 0;
+}
+
+size_t InstantaneaADN::numSecuencias() const {
+    return estaAbierta() ? cabecera().numSecuencias : 0;
+}
+
+string InstantaneaADN::getDescripcion(int i) const {
+    if (i < 0 || i >= longitud()) {
+        return "";
+    }
+    const Registro &r = registro(i);
+    uint64_t total = cabecera().bytes[DESCRIPCIONES];
+    if (r.descripcion > total || r.longDescripcion > total - r.descripcion) {
+        return "";
+    }
+    return string(seccion(DESCRIPCIONES) + r.descripcion, r.longDescripcion);
+}
+
+VistaEmpaquetada InstantaneaADN::vista(int i) const {
+    if (i < 0 || i >= longitud()) {
+        return VistaEmpaquetada();
+    }
+    return vistaSecuencia(registro(i).secuencia);
+}
+
+CadenaADN InstantaneaADN::getCadenaADN(int i) const {
+    if (i < 0 || i >= longitud()) {
+        return CadenaADN();
+    }
+    return CadenaADN(vista(i), getDescripcion(i));
+}
+
+int InstantaneaADN::frecuenciaCodon(const string &c) const {
+    int cod = SecuenciaEmpaquetada::codificarCodon(c);
+    if (cod < 0 || !estaAbierta()) {
+        return 0;
+    }
+    return ((const uint64_t *)seccion(CODONES))[cod];
+}
+
+int InstantaneaADN::frecuenciaCadena(const CadenaADN &c) const {
+    if (!estaAbierta()) {
+        return 0;
+    }
+    int id = buscarSecuencia(c.getSecuenciaEmpaquetada().vista());
+    return id < 0 ? 0 : secuencia(id).referencias;
+}
+
+string InstantaneaADN::listaCodones() const {
+    string res = "";
+    for (int cod = 0; cod < 64; cod++) {
+        if (estaAbierta() && ((const uint64_t *)seccion(CODONES))[cod] > 0) {
+            res += (res == "" ? "" : "\n") + SecuenciaEmpaquetada::decodificarCodon(cod);
+        }
+    }
+    return res;
+}
+
+string InstantaneaADN::listaCadenasADN() const {
+    vector<string> unicas;
+    for (size_t id = 0; id < numSecuencias(); id++) {
+        unicas.push_back(vistaSecuencia(id).decodificar());
+    }
+    return unirOrdenadas(unicas);
+}
+
+string InstantaneaADN::listaCadenasConCodon(const string &codon) const {
+    int cod = SecuenciaEmpaquetada::codificarCodon(codon);
+    if (cod < 0 || !estaAbierta()) {
+        return "";
+    }
+    const uint64_t *csr = (const uint64_t *)seccion(CODONES) + 64;
+    const uint32_t *postings = (const uint32_t *)seccion(POSTINGS);
+    vector<string> seqs;
+    for (uint64_t k = csr[cod]; k < csr[cod + 1]; k++) {
+        seqs.push_back(vistaSecuencia(postings[k]).decodificar());
+    }
+    return unirOrdenadas(seqs);
+}
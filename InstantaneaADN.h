@@ -0,0 +1,85 @@
+#ifndef INSTANTANEAADN_H
+#define INSTANTANEAADN_H
+
+#include <cstdint>
+#include <string>
+#include "CadenaADN.h"
+#include "ListaCadenasADN.h"
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Instantánea binaria de una ListaCadenasADN completa: registros,
+// descripciones, secuencias distintas empaquetadas y los índices ya
+// construidos (tabla por huella, frecuencias y listas por codón).
+// Se abre con mmap: abrir solo comprueba la cabecera y los límites de las
+// secciones, y el sistema trae cada página cuando una consulta la toca.
+// Las consultas trabajan directamente sobre el fichero, sin copiarlo.
+//
+// Formato (versión 1, little-endian, secciones alineadas a 8 bytes):
+//   cabecera | registros | descripciones | secuencias | palabras |
+//   tabla por huella | codones (frecuencias + CSR) | postings por codón
+class InstantaneaADN {
+    private:
+    const char *base = nullptr;
+    size_t tam = 0;
+
+    enum Seccion { REGISTROS, DESCRIPCIONES, SECUENCIAS, PALABRAS, TABLA, CODONES, POSTINGS, NUM_SECCIONES };
+
+    struct Cabecera {
+        char magico[8];
+        uint32_t version;
+        uint32_t reservado;
+        uint64_t numRegistros;
+        uint64_t numSecuencias;
+        uint64_t tamTabla;            // Potencia de 2
+        uint64_t inicio[NUM_SECCIONES];
+        uint64_t bytes[NUM_SECCIONES];
+    };
+    struct Registro {
+        uint32_t secuencia;           // Identificador de la secuencia distinta
+        uint32_t longDescripcion;
+        uint64_t descripcion;         // Desplazamiento en DESCRIPCIONES
+    };
+    struct Secuencia {
+        uint64_t palabra;             // Primera palabra en PALABRAS
+        uint64_t n;                   // Número de bases
+        uint64_t referencias;
+        uint64_t alta, baja;          // Huella
+    };
+
+    const Cabecera &cabecera() const;
+    const char *seccion(Seccion) const;
+    const Registro &registro(int) const;
+    const Secuencia &secuencia(int) const;
+    VistaEmpaquetada vistaSecuencia(int) const;
+    int buscarSecuencia(const VistaEmpaquetada &) const;
+    string unirOrdenadas(vector<string> &) const;
+    public:
+    InstantaneaADN();
+    InstantaneaADN(const InstantaneaADN &) = delete;
+    InstantaneaADN &operator=(const InstantaneaADN &) = delete;
+    ~InstantaneaADN();
+
+    static bool guardar(const ListaCadenasADN &, const string &path);
+
+    bool abrir(const string &path);
+    void cerrar();
+    bool estaAbierta() const;
+
+    int longitud() const;
+    size_t numSecuencias() const;
+    string getDescripcion(int) const;
+    // Secuencia del registro, apuntando al fichero mapeado (sin copia)
+    VistaEmpaquetada vista(int) const;
+    CadenaADN getCadenaADN(int) const;
+
+    // Mismas consultas que ListaCadenasADN, con los índices guardados
+    int frecuenciaCodon(const string &) const;
+    int frecuenciaCadena(const CadenaADN &) const;
+    string listaCodones() const;
+    string listaCadenasADN() const;
+    string listaCadenasConCodon(const string &) const;
+};
+
+#endif // INSTANTANEAADN_H
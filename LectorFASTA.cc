@@ -0,0 +1,208 @@
+#include "LectorFASTA.h"
+#include "SecuenciaEmpaquetada.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// Tabla de bases: la mayúscula correspondiente, o 0 si el carácter no es válido
+struct TablaBases {
+    char tabla[256];
+    TablaBases() {
+        memset(tabla, 0, sizeof(tabla));
+        const char *bases = "ACGT";
+        for (int i = 0; i < 4; i++) {
+            tabla[(unsigned char)bases[i]] = bases[i];
+            tabla[(unsigned char)(bases[i] + ('a' - 'A'))] = bases[i];
+        }
+    }
+};
+
+static const char *tablaBases() {
+    static const TablaBases t;
+    return t.tabla;
+}
+
+LectorFASTA::LectorFASTA(size_t tamBuffer) : buffer(tamBuffer > 0 ? tamBuffer : 1) {}
+
+bool LectorFASTA::abrir(const string &path) {
+    fichero.close();
+    fichero.clear();
+    fichero.open(path, ios::binary);
+    inicio = fin = 0;
+    base = 0;
+    hayPendiente = false;
+    registros = 0;
+    errores.clear();
+    if (!fichero.is_open()) {
+        cout << "Error al abrir el archivo.\n";
+        return false;
+    }
+    return true;
+}
+
+const vector<ErrorLectura> &LectorFASTA::getErrores() const {
+    return errores;
+}
+
+void LectorFASTA::anotarError(long long desplazamiento, int registro, const string &mensaje) {
+    ErrorLectura e;
+    e.desplazamiento = desplazamiento;
+    e.registro = registro;
+    e.mensaje = mensaje;
+    errores.push_back(e);
+}
+
+// Siguiente línea sin el salto (ni '\r'); 'desplazamiento' es donde empieza.
+// Rellena el buffer cuando se agota, así que una línea puede cruzar bloques.
+bool LectorFASTA::leerLinea(string &linea, long long &desplazamiento) {
+    linea.clear();
+    desplazamiento = base + inicio;
+    bool leido = false;
+    while (true) {
+        if (inicio == fin) {
+            base += fin;
+            fichero.read(buffer.data(), buffer.size());
+            fin = fichero.gcount();
+            inicio = 0;
+            if (fin == 0) {
+                break;
+            }
+        }
+        leido = true;
+        const char *p = buffer.data() + inicio;
+        const char *salto = (const char *)memchr(p, '\n', fin - inicio);
+        if (salto != nullptr) {
+            linea.append(p, salto - p);
+            inicio += (salto - p) + 1;
+            break;
+        }
+        linea.append(p, fin - inicio);
+        inicio = fin;
+    }
+    if (!linea.empty() && linea.back() == '\r') {
+        linea.pop_back();
+    }
+    return leido;
+}
+
+// Valida de una vez la secuencia completa del registro: el núcleo vectorial
+// busca el primer carácter que no es una base en mayúscula y solo desde ahí
+// se sigue carácter a carácter (minúsculas, que se convierten, o un error,
+// situado en el fichero gracias al inicio de cada línea).
+bool LectorFASTA::validarBases(string &secuencia, int numero) {
+    long long primera = SecuenciaEmpaquetada::primeraNoValida(secuencia.data(), secuencia.size());
+    if (primera < 0) {
+        return true;
+    }
+    const char *tabla = tablaBases();
+    for (size_t j = primera; j < secuencia.size(); j++) {
+        char b = tabla[(unsigned char)secuencia[j]];
+        if (b == 0) {
+            auto linea = upper_bound(lineas.begin(), lineas.end(), make_pair(j, LLONG_MAX)) - 1;
+            anotarError(linea->second + (long long)(j - linea->first), numero,
+                        string("carácter no válido '") + secuencia[j] + "'");
+            return false;
+        }
+        secuencia[j] = b;
+    }
+    return true;
+}
+
+bool LectorFASTA::siguiente(RegistroFASTA &registro) {
+    string linea;
+    long long desplazamiento;
+
+    while (true) {
+        // Cabecera: la pendiente o la primera línea no vacía
+        string cabecera;
+        long long inicioRegistro;
+        if (hayPendiente) {
+            cabecera.swap(pendiente);
+            inicioRegistro = desplazamientoPendiente;
+            hayPendiente = false;
+        } else {
+            bool suelto = false; // Ya se avisó del texto fuera de registro
+            bool encontrada = false;
+            while (leerLinea(linea, desplazamiento)) {
+                if (linea.empty()) {
+                    continue;
+                }
+                if (linea[0] == '>' || linea[0] == '@') {
+                    cabecera.swap(linea);
+                    inicioRegistro = desplazamiento;
+                    encontrada = true;
+                    break;
+                }
+                if (!suelto) {
+                    anotarError(desplazamiento, registros, "texto fuera de un registro");
+                    suelto = true;
+                }
+            }
+            if (!encontrada) {
+                return false;
+            }
+        }
+
+        int numero = registros++;
+        bool fastq = (cabecera[0] == '@');
+        registro.descripcion = cabecera.substr(1);
+        registro.secuencia.clear();
+        registro.desplazamiento = inicioRegistro;
+        lineas.clear();
+
+        // Secuencia: hasta la siguiente cabecera (FASTA) o la línea '+' (FASTQ).
+        // En FASTA también '@' abre registro, para admitir ficheros mezclados.
+        bool separador = false;
+        while (leerLinea(linea, desplazamiento)) {
+            if (linea.empty()) {
+                continue;
+            }
+            if (!fastq && (linea[0] == '>' || linea[0] == '@')) {
+                pendiente.swap(linea);
+                desplazamientoPendiente = desplazamiento;
+                hayPendiente = true;
+                break;
+            }
+            if (fastq && linea[0] == '+') {
+                separador = true;
+                break;
+            }
+            lineas.push_back(make_pair(registro.secuencia.size(), desplazamiento));
+            registro.secuencia.append(linea);
+        }
+        bool valido = validarBases(registro.secuencia, numero);
+        size_t bases = registro.secuencia.size();
+
+        // Calidades FASTQ: tantas como bases, en una o varias líneas
+        if (fastq) {
+            if (!separador) {
+                if (valido) {
+                    anotarError(inicioRegistro, numero, "registro FASTQ sin línea '+'");
+                }
+                valido = false;
+            } else {
+                size_t calidades = 0;
+                while (calidades < bases && leerLinea(linea, desplazamiento)) {
+                    calidades += linea.size();
+                }
+                if (valido && calidades != bases) {
+                    anotarError(inicioRegistro, numero, "calidades y bases no coinciden en número");
+                    valido = false;
+                }
+            }
+        }
+
+        if (valido) {
+            size_t n = registro.secuencia.size();
+            if (n < 3 || n % 3 != 0) {
+                anotarError(inicioRegistro, numero, "longitud no válida (" + to_string(n) + ")");
+                valido = false;
+            }
+        }
+        if (valido) {
+            return true;
+        }
+    }
+}
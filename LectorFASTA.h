@@ -0,0 +1,64 @@
+#ifndef LECTORFASTA_H
+#define LECTORFASTA_H
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Error en un registro: desplazamiento en bytes desde el principio del
+// fichero, número de registro (desde 0) y motivo
+struct ErrorLectura {
+    long long desplazamiento;
+    int registro;
+    string mensaje;
+};
+
+// Registro leído: descripción (cabecera sin '>' ni '@') y secuencia en mayúsculas
+struct RegistroFASTA {
+    string descripcion;
+    string secuencia;
+    long long desplazamiento; // Inicio de la cabecera
+};
+
+// Lector en streaming de ficheros FASTA y FASTQ con varios registros.
+// Lee el fichero en bloques de tamaño fijo y solo guarda en memoria el
+// registro en curso, así que el consumo no depende del tamaño del fichero.
+//  - FASTA: cabecera '>' y secuencia en una o varias líneas.
+//  - FASTQ: cabecera '@', secuencia, línea '+' y calidades (se descartan).
+// Valida cada secuencia entera al terminar de leerla, con el núcleo
+// vectorial de SecuenciaEmpaquetada: solo A, C, G, T (se aceptan minúsculas),
+// longitud múltiplo de 3 y al menos 3. Los registros no válidos se saltan y se
+// anotan en getErrores().
+class LectorFASTA {
+    private:
+    ifstream fichero;
+    vector<char> buffer;
+    size_t inicio = 0, fin = 0;     // Parte del buffer aún sin consumir
+    long long base = 0;             // Desplazamiento en el fichero de buffer[0]
+    bool hayPendiente = false;      // Cabecera ya leída del registro siguiente
+    string pendiente;
+    long long desplazamientoPendiente = 0;
+    int registros = 0;
+    vector<ErrorLectura> errores;
+    // Inicio de cada línea del registro en curso: posición en la secuencia
+    // y desplazamiento en el fichero (para situar los errores)
+    vector<pair<size_t, long long>> lineas;
+
+    bool leerLinea(string &, long long &);
+    bool validarBases(string &, int);
+    void anotarError(long long, int, const string &);
+    public:
+    static const size_t TAM_BUFFER = 1 << 20;
+
+    LectorFASTA(size_t tamBuffer = TAM_BUFFER);
+
+    bool abrir(const string &);
+    // Lee el siguiente registro válido; false al llegar al final
+    bool siguiente(RegistroFASTA &);
+    const vector<ErrorLectura> &getErrores() const;
+};
+
+#endif // LECTORFASTA_H
@@ -1,150 +1,594 @@
 #include "ListaCadenasADN.h"
+#include "Paralelo.h"
+#include "InstantaneaADN.h"
 #include <sstream>
 #include <algorithm>
 #include <unordered_set>
+#include <atomic>
 
-IteradorLista::IteradorLista() : vacio(true) {}
-IteradorLista::IteradorLista(const IteradorLista& other) : iter(other.iter), vacio(other.vacio) {}
+// --- RegistroLista ---
+RegistroLista::RegistroLista(const ListaCadenasADN* l, int r) : lista(l), registro(r) {}
+VistaEmpaquetada RegistroLista::vista() const { return lista->secuencias.vista(lista->secuenciaRegistro[registro]); }
+string RegistroLista::getSecuencia() const { return vista().decodificar(); }
+string RegistroLista::getDescripcion() const { return lista->descripcionDe(registro); }
+int RegistroLista::getLongitud() const { return vista().longitud(); }
+CadenaADN RegistroLista::cadena() const { return CadenaADN(vista(), getDescripcion()); }
+
+// --- IteradorLista ---
+IteradorLista::IteradorLista() : lista(nullptr), registro(0), vacio(true) {}
+IteradorLista::IteradorLista(const IteradorLista& other) : lista(other.lista), registro(other.registro), vacio(other.vacio) {}
 IteradorLista::~IteradorLista() {}
 IteradorLista& IteradorLista::operator=(const IteradorLista& other) {
-    if (this != &other) { iter = other.iter; vacio = other.vacio; }
+    if (this != &other) { lista = other.lista; registro = other.registro; vacio = other.vacio; }
     return *this;
 }
-void IteradorLista::step() { if (!vacio) ++iter; }
-void IteradorLista::rstep() { if (!vacio) --iter; }
+void IteradorLista::step() { if (!vacio) registro = lista->siguiente[registro]; }
+void IteradorLista::rstep() { if (!vacio) registro = lista->anterior[registro]; }
 bool IteradorLista::operator==(const IteradorLista& other) const {
     if (vacio && other.vacio) return true;
     if (vacio || other.vacio) return false;
-    return iter == other.iter;
+    return lista == other.lista && registro == other.registro;
 }
 bool IteradorLista::operator!=(const IteradorLista& other) const { return !(*this == other); }
 bool IteradorLista::esVacio() const { return vacio; }
+RegistroLista IteradorLista::operator*() const { return RegistroLista(lista, registro); }
+RegistroLista IteradorLista::operator->() const { return RegistroLista(lista, registro); }
 
 // --- ListaCadenasADN ---
-ListaCadenasADN::ListaCadenasADN() {}
-ListaCadenasADN::ListaCadenasADN(const ListaCadenasADN& other) { *this = other; }
+// El hueco 0 es el centinela: siguiente[0] es el primero y anterior[0] el último
+ListaCadenasADN::ListaCadenasADN()
+    : secuenciaRegistro(1, -1), inicioDescripcion(1, 0), longDescripcion(1, 0), siguiente(1, 0), anterior(1, 0),
+      numRegistros(0), bytesMuertos(0), indicesPendientes(false), cargasAbiertas(0) { frecCodones.fill(0); }
+ListaCadenasADN::ListaCadenasADN(const ListaCadenasADN& other) : ListaCadenasADN() { *this = other; }
+// Cada columna se construye por movimiento, sin reservar nada. La lista origen
+// queda vacía y sin centinela: solo puede destruirse o recibir una asignación
+ListaCadenasADN::ListaCadenasADN(ListaCadenasADN&& other) noexcept
+    : secuenciaRegistro(std::move(other.secuenciaRegistro)), inicioDescripcion(std::move(other.inicioDescripcion)),
+      longDescripcion(std::move(other.longDescripcion)), siguiente(std::move(other.siguiente)),
+      anterior(std::move(other.anterior)), huecosLibres(std::move(other.huecosLibres)), numRegistros(other.numRegistros),
+      descripciones(std::move(other.descripciones)), bytesMuertos(other.bytesMuertos),
+      secuencias(std::move(other.secuencias)), frecCodones(other.frecCodones),
+      secuenciasConCodon(std::move(other.secuenciasConCodon)), indicesPendientes(other.indicesPendientes),
+      cargasAbiertas(0) {
+    other.numRegistros = 0;
+    other.bytesMuertos = 0;
+    other.frecCodones.fill(0);
+    other.indicesPendientes = false;
+}
+// Las asignaciones no tocan cargasAbiertas: las sesiones de carga abiertas
+// pertenecen a este objeto (se cerrarán sobre él), no a su contenido
 ListaCadenasADN& ListaCadenasADN::operator=(const ListaCadenasADN& other) {
     if (this != &other) {
-        data = other.data;
-        frecSecuencias = other.frecSecuencias;
+        secuenciaRegistro = other.secuenciaRegistro;
+        inicioDescripcion = other.inicioDescripcion;
+        longDescripcion = other.longDescripcion;
+        siguiente = other.siguiente;
+        anterior = other.anterior;
+        huecosLibres = other.huecosLibres;
+        numRegistros = other.numRegistros;
+        descripciones = other.descripciones;
+        bytesMuertos = other.bytesMuertos;
+        secuencias = other.secuencias;
         frecCodones = other.frecCodones;
-        codonesUnicos = other.codonesUnicos;
-        mapaCodonSecuencias = other.mapaCodonSecuencias;
+        secuenciasConCodon = other.secuenciasConCodon;
+        indicesPendientes = other.indicesPendientes;
+    }
+    return *this;
+}
+ListaCadenasADN& ListaCadenasADN::operator=(ListaCadenasADN&& other) noexcept {
+    if (this != &other) {
+        swap(secuenciaRegistro, other.secuenciaRegistro);
+        swap(inicioDescripcion, other.inicioDescripcion);
+        swap(longDescripcion, other.longDescripcion);
+        swap(siguiente, other.siguiente);
+        swap(anterior, other.anterior);
+        swap(huecosLibres, other.huecosLibres);
+        swap(numRegistros, other.numRegistros);
+        swap(descripciones, other.descripciones);
+        swap(bytesMuertos, other.bytesMuertos);
+        swap(secuencias, other.secuencias);
+        swap(frecCodones, other.frecCodones);
+        swap(secuenciasConCodon, other.secuenciasConCodon);
+        swap(indicesPendientes, other.indicesPendientes);
     }
     return *this;
 }
 ListaCadenasADN::~ListaCadenasADN() {}
 
-void ListaCadenasADN::actualizarEstructuras(const CadenaADN& cadena, int inc) {
-    string seq = cadena.getSecuencia();
-    frecSecuencias[seq] += inc;
-    if (frecSecuencias[seq] <= 0) frecSecuencias.erase(seq);
-
-    vector<string> cods = cadena.obtenerCodones();
-    for (const string& c : cods) {
-        frecCodones[c] += inc;
-        
-        if (inc > 0) {
-            codonesUnicos[c] = true;
-            mapaCodonSecuencias[c][seq] = true;
-        } else {
-            // Si estamos borrando (inc < 0)
-            if (frecCodones[c] <= 0) {
-                frecCodones.erase(c);
-                codonesUnicos.erase(c);
-                mapaCodonSecuencias.erase(c);
-            } else {
-                // Si el codón aún existe en otras cadenas, 
-                // pero queremos ver si esta secuencia específica ya no lo tiene
-                if (frecSecuencias[seq] <= 0) {
-                    mapaCodonSecuencias[c].erase(seq);
-                }
-            }
+// Las listas de secuencias por codón solo cambian cuando una secuencia
+// aparece por primera vez o desaparece del todo
+int ListaCadenasADN::altaSecuencia(const VistaEmpaquetada& v, const Huella& h) {
+    bool nueva = false;
+    int id = secuencias.adquirir(v, h, nueva);
+    if (cargasAbiertas > 0) indicesPendientes = true;
+    if (indicesPendientes) return id;
+    uint64_t presentes = 0; // Codones distintos de la secuencia
+    for (int cod : VistaCodones(secuencias.vista(id))) { frecCodones[cod]++; presentes |= 1ULL << cod; }
+    if (nueva) {
+        for (int cod = 0; cod < 64; cod++) {
+            if (!(presentes >> cod & 1)) continue;
+            vector<int>& ids = secuenciasConCodon[cod];
+            ids.insert(lower_bound(ids.begin(), ids.end(), id), id);
         }
     }
+    return id;
+}
+// Las postings se actualizan antes de liberar el id, que puede reutilizarse
+void ListaCadenasADN::bajaSecuencia(int id) {
+    if (cargasAbiertas > 0) indicesPendientes = true;
+    if (indicesPendientes) { secuencias.liberar(id); return; }
+    uint64_t presentes = 0;
+    for (int cod : VistaCodones(secuencias.vista(id))) { frecCodones[cod]--; presentes |= 1ULL << cod; }
+    if (secuencias.referencias(id) == 1) {
+        for (int cod = 0; cod < 64; cod++) {
+            if (!(presentes >> cod & 1)) continue;
+            vector<int>& ids = secuenciasConCodon[cod];
+            auto it = lower_bound(ids.begin(), ids.end(), id);
+            if (it != ids.end() && *it == id) ids.erase(it);
+        }
+    }
+    secuencias.liberar(id);
 }
 
-IteradorLista ListaCadenasADN::begin() { IteradorLista it; it.iter = data.begin(); it.vacio = false; return it; }
-IteradorLista ListaCadenasADN::end() { IteradorLista it; it.iter = data.end(); it.vacio = false; return it; }
-IteradorLista ListaCadenasADN::rbegin() { IteradorLista it; if (data.empty()) it = end(); else { it.iter = --data.end(); it.vacio = false; } return it; }
-IteradorLista ListaCadenasADN::rend() { IteradorLista it; it.iter = --data.begin(); it.vacio = false; return it; }
+// Ocupa un hueco (reutilizando los libres) y lo enlaza justo antes de 'antesDe'.
+// No toca los índices: la secuencia 'id' ya debe estar contada en el pool.
+int ListaCadenasADN::enlazarRegistro(int antesDe, int id, const string& desc) {
+    int r;
+    if (huecosLibres.empty()) {
+        r = secuenciaRegistro.size();
+        secuenciaRegistro.push_back(id);
+        inicioDescripcion.push_back(0); longDescripcion.push_back(0);
+        siguiente.push_back(0); anterior.push_back(0);
+    } else {
+        r = huecosLibres.back(); huecosLibres.pop_back();
+        secuenciaRegistro[r] = id;
+    }
+    inicioDescripcion[r] = descripciones.size(); longDescripcion[r] = desc.size();
+    descripciones += desc;
+    int previo = anterior[antesDe];
+    siguiente[r] = antesDe; anterior[r] = previo;
+    siguiente[previo] = r; anterior[antesDe] = r;
+    numRegistros++;
+    return r;
+}
+void ListaCadenasADN::desenlazarRegistro(int r) {
+    siguiente[anterior[r]] = siguiente[r]; anterior[siguiente[r]] = anterior[r];
+    secuenciaRegistro[r] = -1;
+    bytesMuertos += longDescripcion[r]; longDescripcion[r] = 0;
+    huecosLibres.push_back(r);
+    numRegistros--;
+}
+int ListaCadenasADN::nuevoRegistro(int antesDe, const VistaEmpaquetada& v, const Huella& h, const string& desc) {
+    return enlazarRegistro(antesDe, altaSecuencia(v, h), desc);
+}
+int ListaCadenasADN::nuevoRegistro(int antesDe, const CadenaADN& c) {
+    VistaEmpaquetada v = c.getSecuenciaEmpaquetada().vista();
+    return nuevoRegistro(antesDe, v, v.huella(), c.getDescripcion());
+}
+void ListaCadenasADN::quitarRegistro(int r) {
+    bajaSecuencia(secuenciaRegistro[r]);
+    desenlazarRegistro(r);
+    if (bytesMuertos >= MIN_COMPACTAR && 2 * bytesMuertos > descripciones.size()) compactarDescripciones();
+}
+void ListaCadenasADN::fijarDescripcion(int r, const string& desc) {
+    bytesMuertos += longDescripcion[r];
+    inicioDescripcion[r] = descripciones.size(); longDescripcion[r] = desc.size();
+    descripciones += desc;
+    if (bytesMuertos >= MIN_COMPACTAR && 2 * bytesMuertos > descripciones.size()) compactarDescripciones();
+}
+// Reescribe la arena en el orden de la lista
+void ListaCadenasADN::compactarDescripciones() {
+    string nueva;
+    nueva.reserve(descripciones.size() - bytesMuertos);
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) {
+        size_t inicio = nueva.size();
+        nueva.append(descripciones, inicioDescripcion[r], longDescripcion[r]);
+        inicioDescripcion[r] = inicio;
+    }
+    descripciones.swap(nueva);
+    bytesMuertos = 0;
+}
+string ListaCadenasADN::descripcionDe(int r) const { return descripciones.substr(inicioDescripcion[r], longDescripcion[r]); }
 
-CadenaADN ListaCadenasADN::getCadenaADN(IteradorLista it) { return (it.esVacio() || it.iter == data.end()) ? CadenaADN() : *it.iter; }
-bool ListaCadenasADN::esVacia() { return data.empty(); }
-void ListaCadenasADN::insertarInicio(const CadenaADN& c) { data.push_front(c); actualizarEstructuras(c, 1); }
-void ListaCadenasADN::insertarFinal(const CadenaADN& c) { data.push_back(c); actualizarEstructuras(c, 1); }
+// El iterador debe ser de esta lista y no vacío; end() solo si se admite
+bool ListaCadenasADN::esPropio(const IteradorLista& it, bool admiteFin) const {
+    return !it.esVacio() && it.lista == this && (admiteFin || it.registro != 0);
+}
+
+// Identificador de la secuencia de la cadena, o -1 si no está en la lista
+int ListaCadenasADN::buscarId(const CadenaADN& c) const {
+    return secuencias.buscar(c.getSecuenciaEmpaquetada().vista());
+}
+
+IteradorLista ListaCadenasADN::begin() { IteradorLista it; it.lista = this; it.registro = siguiente[0]; it.vacio = false; return it; }
+IteradorLista ListaCadenasADN::end() { IteradorLista it; it.lista = this; it.registro = 0; it.vacio = false; return it; }
+IteradorLista ListaCadenasADN::rbegin() { IteradorLista it; it.lista = this; it.registro = anterior[0]; it.vacio = false; return it; }
+IteradorLista ListaCadenasADN::rend() { return end(); }
+
+CadenaADN ListaCadenasADN::getCadenaADN(IteradorLista it) { return esPropio(it, false) ? (*it).cadena() : CadenaADN(); }
+bool ListaCadenasADN::esVacia() { return numRegistros == 0; }
+void ListaCadenasADN::insertarInicio(const CadenaADN& c) { nuevoRegistro(siguiente[0], c); }
+void ListaCadenasADN::insertarFinal(const CadenaADN& c) { nuevoRegistro(0, c); }
 
 bool ListaCadenasADN::insertar(IteradorLista it, const CadenaADN& c) {
-    if (it.esVacio()) return false;
-    data.insert(it.iter, c); actualizarEstructuras(c, 1); return true;
+    if (!esPropio(it, true)) return false;
+    nuevoRegistro(it.registro, c); return true;
 }
 bool ListaCadenasADN::insertarDespues(IteradorLista it, const CadenaADN& c) {
-    if (it.esVacio() || it.iter == data.end()) return false;
-    auto next = it.iter; data.insert(++next, c); actualizarEstructuras(c, 1); return true;
+    if (!esPropio(it, false)) return false;
+    nuevoRegistro(siguiente[it.registro], c); return true;
 }
+// Se adquiere la secuencia nueva antes de soltar la vieja por si son la misma
 bool ListaCadenasADN::asignar(IteradorLista it, const CadenaADN& c) {
-    if (it.esVacio() || it.iter == data.end()) return false;
-    actualizarEstructuras(*it.iter, -1); *it.iter = c; actualizarEstructuras(c, 1); return true;
+    if (!esPropio(it, false)) return false;
+    VistaEmpaquetada v = c.getSecuenciaEmpaquetada().vista();
+    int viejo = secuenciaRegistro[it.registro];
+    secuenciaRegistro[it.registro] = altaSecuencia(v, v.huella());
+    bajaSecuencia(viejo);
+    fijarDescripcion(it.registro, c.getDescripcion());
+    return true;
 }
-bool ListaCadenasADN::borrarPrimera() { if (data.empty()) return false; actualizarEstructuras(data.front(), -1); data.pop_front(); return true; }
-bool ListaCadenasADN::borrarUltima() { if (data.empty()) return false; actualizarEstructuras(data.back(), -1); data.pop_back(); return true; }
+bool ListaCadenasADN::borrarPrimera() { if (numRegistros == 0) return false; quitarRegistro(siguiente[0]); return true; }
+bool ListaCadenasADN::borrarUltima() { if (numRegistros == 0) return false; quitarRegistro(anterior[0]); return true; }
 bool ListaCadenasADN::borrar(IteradorLista &it) {
-    if (it.esVacio() || it.iter == data.end()) return false;
-    actualizarEstructuras(*it.iter, -1); data.erase(it.iter); it = IteradorLista(); return true;
+    if (!esPropio(it, false)) return false;
+    quitarRegistro(it.registro); it = IteradorLista(); return true;
 }
 
-int ListaCadenasADN::longitud() { return data.size(); }
-int ListaCadenasADN::contar(const CadenaADN& c) { return frecSecuencias[c.getSecuencia()]; }
+int ListaCadenasADN::longitud() { return numRegistros; }
+int ListaCadenasADN::contar(const CadenaADN& c) { int id = buscarId(c); return id < 0 ? 0 : secuencias.referencias(id); }
 
+// Se copian las secuencias empaquetadas con su huella, sin volver a calcularla
 ListaCadenasADN ListaCadenasADN::concatenar(ListaCadenasADN& otra) {
     ListaCadenasADN res = *this;
-    for (auto& c : otra.data) res.insertarFinal(c);
+    for (int r = otra.siguiente[0]; r != 0; r = otra.siguiente[r]) {
+        int id = otra.secuenciaRegistro[r];
+        res.nuevoRegistro(0, otra.secuencias.vista(id), otra.secuencias.huella(id), otra.descripcionDe(r));
+    }
     return res;
 }
+// Se consulta 'otra' una vez por secuencia distinta (en paralelo, con la
+// huella ya calculada) y el resultado se construye sin actualizar índices
+// registro a registro: se reconstruyen una sola vez al final
 ListaCadenasADN ListaCadenasADN::diferencia(ListaCadenasADN& otra) {
+    size_t capacidad = secuencias.capacidad();
+    vector<char> enOtra(capacidad, 0);
+    paraleloPorBloques(capacidad, GRANO_PARALELO, [&](size_t ini, size_t fin) {
+        for (size_t id = ini; id < fin; id++)
+            if (secuencias.referencias(id) > 0)
+                enOtra[id] = otra.secuencias.buscar(secuencias.vista(id), secuencias.huella(id)) >= 0;
+    });
+
     ListaCadenasADN res;
-    for (auto& c : data) if (otra.frecSecuencias.find(c.getSecuencia()) == otra.frecSecuencias.end()) res.insertarFinal(c);
+    vector<int> idRes(capacidad, -1), cuenta(capacidad, 0);
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) {
+        int id = secuenciaRegistro[r];
+        if (enOtra[id]) continue;
+        if (idRes[id] < 0) { bool nueva; idRes[id] = res.secuencias.adquirir(secuencias.vista(id), secuencias.huella(id), nueva); }
+        cuenta[id]++;
+        res.enlazarRegistro(0, idRes[id], descripcionDe(r));
+    }
+    for (size_t id = 0; id < capacidad; id++) if (idRes[id] >= 0) res.secuencias.fijarReferencias(idRes[id], cuenta[id]);
+    res.reconstruirIndices();
     return res;
 }
+// Se empaqueta directamente desde la cuerda: sin pasar por texto ni volver
+// a validar bases que ya estaban validadas en cada registro. La cadena
+// adopta el resultado, así que la secuencia completa solo existe una vez
 CadenaADN ListaCadenasADN::concatenar() {
-    string s = ""; for (auto& c : data) s += c.getSecuencia();
-    return CadenaADN(s, "");
+    return CadenaADN(cuerda().empaquetar(), "");
+}
+CuerdaADN ListaCadenasADN::cuerda() const {
+    CuerdaADN c;
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) c.anadir(secuencias.vista(secuenciaRegistro[r]));
+    return c;
 }
 string ListaCadenasADN::aCadena() {
     stringstream ss;
-    for (auto it = data.begin(); it != data.end(); ++it) {
-        ss << it->getDescripcion() << ":" << it->getSecuencia();
-        if (next(it) != data.end()) ss << "\n";
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) {
+        ss << descripcionDe(r) << ":" << secuencias.vista(secuenciaRegistro[r]).decodificar();
+        if (siguiente[r] != 0) ss << "\n";
     }
     return ss.str();
 }
 
-int ListaCadenasADN::frecuenciaCodon(const string& c) { return frecCodones[c]; }
-int ListaCadenasADN::frecuenciaCadena(const CadenaADN& c) { return frecSecuencias[c.getSecuencia()]; }
+int ListaCadenasADN::frecuenciaCodon(const string& c) {
+    asegurarIndices();
+    int cod = SecuenciaEmpaquetada::codificarCodon(c);
+    return cod < 0 ? 0 : frecCodones[cod];
+}
+int ListaCadenasADN::frecuenciaCadena(const CadenaADN& c) { return contar(c); }
 
+// El orden de los códigos coincide con el alfabético
 string ListaCadenasADN::listaCodones() {
+    asegurarIndices();
     string res = "";
-    for (auto const& [codon, val] : codonesUnicos) res += (res == "" ? "" : "\n") + codon;
+    for (int cod = 0; cod < 64; cod++)
+        if (frecCodones[cod] > 0) res += (res == "" ? "" : "\n") + SecuenciaEmpaquetada::decodificarCodon(cod);
     return res;
 }
 string ListaCadenasADN::listaCadenasADN() {
-    map<string, bool> unicas; for (auto& c : data) unicas[c.getSecuencia()] = true;
+    vector<string> unicas;
+    for (size_t id = 0; id < secuencias.capacidad(); id++)
+        if (secuencias.referencias(id) > 0) unicas.push_back(secuencias.vista(id).decodificar());
+    sort(unicas.begin(), unicas.end());
     string res = "";
-    for (auto const& [seq, val] : unicas) res += (res == "" ? "" : "\n") + seq;
+    for (const string& seq : unicas) res += (res == "" ? "" : "\n") + seq;
     return res;
 }
 string ListaCadenasADN::listaCadenasConCodon(const string& codon) {
+    int cod = SecuenciaEmpaquetada::codificarCodon(codon);
+    if (cod < 0) return "";
+    asegurarIndices();
+    vector<string> seqs;
+    for (int id : secuenciasConCodon[cod]) seqs.push_back(secuencias.vista(id).decodificar());
+    sort(seqs.begin(), seqs.end());
     string res = "";
-    if (mapaCodonSecuencias.count(codon))
-        for (auto const& [seq, val] : mapaCodonSecuencias[codon]) res += (res == "" ? "" : "\n") + seq;
+    for (const string& seq : seqs) res += (res == "" ? "" : "\n") + seq;
     return res;
 }
+// Las secuencias ya están repartidas por huella en el pool: cada registro
+// calcula en paralelo la primera posición de su identificador (mínimo
+// atómico), se desenlazan los que no son la primera y los índices se
+// reconstruyen una sola vez (las secuencias distintas no cambian)
 void ListaCadenasADN::eliminaDuplicados() {
-    unordered_set<string> vistas;
-    for (auto it = data.begin(); it != data.end(); ) {
-        if (vistas.count(it->getSecuencia())) {
-            actualizarEstructuras(*it, -1);
-            it = data.erase(it);
-        } else { vistas.insert(it->getSecuencia()); ++it; }
+    vector<int> registros;
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) registros.push_back(r);
+    size_t capacidad = secuencias.capacidad();
+    vector<atomic<size_t>> primera(capacidad);
+    for (auto& p : primera) p.store(registros.size(), memory_order_relaxed);
+    paraleloPorBloques(registros.size(), GRANO_PARALELO, [&](size_t ini, size_t fin) {
+        for (size_t k = ini; k < fin; k++) {
+            atomic<size_t>& p = primera[secuenciaRegistro[registros[k]]];
+            size_t actual = p.load(memory_order_relaxed);
+            while (k < actual && !p.compare_exchange_weak(actual, k, memory_order_relaxed)) {}
+        }
+    });
+
+    bool hayDuplicados = false;
+    for (size_t k = 0; k < registros.size(); k++) {
+        if (primera[secuenciaRegistro[registros[k]]].load(memory_order_relaxed) != k) {
+            desenlazarRegistro(registros[k]);
+            hayDuplicados = true;
+        }
     }
-}
\ No newline at end of file
+    if (!hayDuplicados) return;
+    for (size_t id = 0; id < capacidad; id++) secuencias.fijarReferencias(id, 1);
+    reconstruirIndices();
+    if (bytesMuertos >= MIN_COMPACTAR && 2 * bytesMuertos > descripciones.size()) compactarDescripciones();
+}
+
+vector<CoincidenciaPatron> ListaCadenasADN::buscarPatrones(const BuscadorMultiple& buscador) {
+    vector<VistaEmpaquetada> registros;
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) registros.push_back(secuencias.vista(secuenciaRegistro[r]));
+
+    // Cada registro escribe en su propio vector: el resultado no depende del reparto entre hilos
+    vector<vector<CoincidenciaPatron>> parciales(registros.size());
+    paraleloPorBloques(registros.size(), 64, [&](size_t ini, size_t fin) {
+        for (size_t r = ini; r < fin; r++)
+            buscador.buscar(registros[r], r, parciales[r]);
+    });
+
+    vector<CoincidenciaPatron> res;
+    for (auto& p : parciales) res.insert(res.end(), p.begin(), p.end());
+    return res;
+}
+
+vector<CoincidenciaAproximada> ListaCadenasADN::buscarAproximada(const string& patron, int maxErrores) {
+    BuscadorAproximado buscador(patron, maxErrores);
+    vector<VistaEmpaquetada> registros;
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) registros.push_back(secuencias.vista(secuenciaRegistro[r]));
+
+    vector<vector<CoincidenciaAproximada>> parciales(registros.size());
+    paraleloPorBloques(registros.size(), 64, [&](size_t ini, size_t fin) {
+        for (size_t r = ini; r < fin; r++)
+            buscador.buscar(registros[r], r, parciales[r]);
+    });
+
+    vector<CoincidenciaAproximada> res;
+    for (auto& p : parciales) res.insert(res.end(), p.begin(), p.end());
+    return res;
+}
+
+vector<MarcoAbierto> ListaCadenasADN::buscarORFs(int minAminoacidos) {
+    vector<int> ids, posicion;
+    secuenciasDistintas(ids, posicion);
+    vector<vector<MarcoAbierto>> porSecuencia(ids.size());
+    paraleloPorBloques(ids.size(), 64, [&](size_t ini, size_t fin) {
+        for (size_t k = ini; k < fin; k++)
+            CodigoGenetico::buscarORFs(secuencias.vista(ids[k]), max(minAminoacidos, 0), 0, porSecuencia[k]);
+    });
+
+    vector<MarcoAbierto> res;
+    for (size_t r = 0; r < posicion.size(); r++)
+        for (MarcoAbierto orf : porSecuencia[posicion[r]]) { orf.secuencia = r; res.push_back(orf); }
+    return res;
+}
+
+// Cada secuencia distinta se recorre una vez y sus codones cuentan tantas
+// veces como referencias tenga; las listas por codón salen ya ordenadas
+void ListaCadenasADN::reconstruirIndices() const {
+    size_t capacidad = secuencias.capacidad();
+    vector<uint64_t> presentes(capacidad, 0);
+    array<int, 64> ceros;
+    ceros.fill(0);
+    frecCodones = reducirPorBloques(capacidad, GRANO_PARALELO, ceros, [&](size_t ini, size_t fin) {
+        array<int, 64> parcial;
+        parcial.fill(0);
+        for (size_t id = ini; id < fin; id++) {
+            int refs = secuencias.referencias(id);
+            if (refs == 0) continue;
+            for (int cod : VistaCodones(secuencias.vista(id))) { parcial[cod] += refs; presentes[id] |= 1ULL << cod; }
+        }
+        return parcial;
+    }, [](array<int, 64> a, const array<int, 64>& b) { for (int c = 0; c < 64; c++) a[c] += b[c]; return a; });
+
+    for (auto& ids : secuenciasConCodon) ids.clear();
+    for (size_t id = 0; id < capacidad; id++)
+        for (uint64_t m = presentes[id]; m != 0; m &= m - 1) secuenciasConCodon[__builtin_ctzll(m)].push_back(id);
+    indicesPendientes = false;
+}
+void ListaCadenasADN::asegurarIndices() const { if (indicesPendientes) reconstruirIndices(); }
+
+// Las huellas (lo más costoso por registro) se calculan en paralelo; el
+// internado en el pool y el enlace de registros son secuenciales y baratos
+void ListaCadenasADN::insertarBloque(const vector<const CadenaADN*>& cadenas) {
+    vector<Huella> huellas(cadenas.size());
+    paraleloPorBloques(cadenas.size(), GRANO_PARALELO, [&](size_t ini, size_t fin) {
+        for (size_t k = ini; k < fin; k++) huellas[k] = cadenas[k]->getSecuenciaEmpaquetada().vista().huella();
+    });
+    SesionCarga sesion(*this);
+    for (size_t k = 0; k < cadenas.size(); k++)
+        nuevoRegistro(0, cadenas[k]->getSecuenciaEmpaquetada().vista(), huellas[k], cadenas[k]->getDescripcion());
+}
+
+// --- SesionCarga ---
+SesionCarga::SesionCarga(ListaCadenasADN& l) : lista(&l) { lista->cargasAbiertas++; }
+SesionCarga::~SesionCarga() { confirmar(); }
+void SesionCarga::confirmar() {
+    if (lista == nullptr) return;
+    if (--lista->cargasAbiertas == 0) lista->asegurarIndices();
+    lista = nullptr;
+}
+
+template <class T, class A, class R>
+T ListaCadenasADN::reducirSecuencias(const T& neutro, A acumular, R combinar) const {
+    return reducirPorBloques(secuencias.capacidad(), GRANO_PARALELO, neutro, [&](size_t ini, size_t fin) {
+        T parcial = neutro;
+        for (size_t id = ini; id < fin; id++) {
+            int refs = secuencias.referencias(id);
+            if (refs > 0) acumular(parcial, secuencias.vista(id), refs);
+        }
+        return parcial;
+    }, combinar);
+}
+
+vector<int> ListaCadenasADN::distribucionGC(int intervalos) {
+    if (intervalos <= 0) return vector<int>();
+    return reducirSecuencias(vector<int>(intervalos, 0),
+        [intervalos](vector<int>& h, const VistaEmpaquetada& v, int refs) {
+            Composicion c = v.composicion();
+            size_t k = c.gc() * intervalos / c.total();
+            h[min<size_t>(k, intervalos - 1)] += refs;
+        },
+        [](vector<int> a, const vector<int>& b) { for (size_t k = 0; k < a.size(); k++) a[k] += b[k]; return a; });
+}
+// Mismo criterio que CadenaADN::cumpleChargaff
+int ListaCadenasADN::contarChargaff() {
+    return reducirSecuencias(0,
+        [](int& total, const VistaEmpaquetada& v, int refs) {
+            Composicion c = v.composicion();
+            if (c.cuentas[0] == c.cuentas[3] && c.cuentas[1] == c.cuentas[2]) total += refs;
+        },
+        [](int a, int b) { return a + b; });
+}
+int ListaCadenasADN::rachaMaxima() {
+    return reducirSecuencias(0,
+        [](int& maximo, const VistaEmpaquetada& v, int) {
+            int rachas[4];
+            v.rachasMaximas(rachas);
+            maximo = max(maximo, *max_element(rachas, rachas + 4));
+        },
+        [](int a, int b) { return max(a, b); });
+}
+array<int, 64> ListaCadenasADN::usoCodones() { asegurarIndices(); return frecCodones; }
+
+int ListaCadenasADN::distanciaMutaciones(const VistaEmpaquetada& a, const VistaEmpaquetada& b, int umbral) {
+    if (a.longitud() != b.longitud()) return -1;
+    if (umbral < 0) return a.distanciaHamming(b);
+    size_t d = a.distanciaHammingAcotada(b, umbral);
+    return d > (size_t)umbral ? -1 : (int)d;
+}
+void ListaCadenasADN::secuenciasDistintas(vector<int>& ids, vector<int>& posicion) const {
+    vector<int> densa(secuencias.capacidad(), -1);
+    ids.clear(); posicion.clear();
+    for (int r = siguiente[0]; r != 0; r = siguiente[r]) {
+        int id = secuenciaRegistro[r];
+        if (densa[id] < 0) { densa[id] = ids.size(); ids.push_back(id); }
+        posicion.push_back(densa[id]);
+    }
+}
+// Se rellena primero la matriz entre secuencias distintas, por teselas del
+// triángulo superior: cada tesela compara dos grupos de TESELA_MATRIZ
+// secuencias que caben juntos en caché, y escribe en su bloque y en el simétrico
+vector<int> ListaCadenasADN::matrizMutaciones(int umbral) {
+    vector<int> ids, posicion;
+    secuenciasDistintas(ids, posicion);
+    size_t d = ids.size(), n = posicion.size();
+    vector<VistaEmpaquetada> vistas(d);
+    for (size_t k = 0; k < d; k++) vistas[k] = secuencias.vista(ids[k]);
+
+    size_t lados = (d + TESELA_MATRIZ - 1) / TESELA_MATRIZ;
+    vector<pair<size_t, size_t> > teselas;
+    for (size_t ti = 0; ti < lados; ti++)
+        for (size_t tj = ti; tj < lados; tj++) teselas.push_back(make_pair(ti, tj));
+
+    vector<int> distintas(d * d, 0);
+    paraleloPorBloques(teselas.size(), 1, [&](size_t ini, size_t fin) {
+        for (size_t t = ini; t < fin; t++) {
+            size_t i0 = teselas[t].first * TESELA_MATRIZ, j0 = teselas[t].second * TESELA_MATRIZ;
+            for (size_t i = i0; i < min(d, i0 + TESELA_MATRIZ); i++)
+                for (size_t j = max(j0, i + 1); j < min(d, j0 + TESELA_MATRIZ); j++)
+                    distintas[i * d + j] = distintas[j * d + i] = distanciaMutaciones(vistas[i], vistas[j], umbral);
+        }
+    });
+
+    vector<int> res(n * n);
+    paraleloPorBloques(n, GRANO_PARALELO, [&](size_t ini, size_t fin) {
+        for (size_t a = ini; a < fin; a++)
+            for (size_t b = 0; b < n; b++) res[a * n + b] = distintas[posicion[a] * d + posicion[b]];
+    });
+    return res;
+}
+ContadorKmers ListaCadenasADN::contarKmers(int k, bool canonicos) {
+    ContadorKmers contador(k, canonicos);
+    vector<VistaEmpaquetada> vistas;
+    vector<uint64_t> pesos;
+    for (size_t id = 0; id < secuencias.capacidad(); id++) {
+        int refs = secuencias.referencias(id);
+        if (refs > 0) { vistas.push_back(secuencias.vista(id)); pesos.push_back(refs); }
+    }
+    contador.contar(vistas, pesos);
+    return contador;
+}
+vector<pair<string, uint64_t> > ListaCadenasADN::kmersFrecuentes(int k, size_t n, bool canonicos) {
+    return contarKmers(k, canonicos).masFrecuentes(n);
+}
+vector<uint64_t> ListaCadenasADN::histogramaKmers(int k, size_t maximo, bool canonicos) {
+    return contarKmers(k, canonicos).histograma(maximo);
+}
+// La firma de cada secuencia distinta se calcula una vez
+IndiceMinHash ListaCadenasADN::indiceMinHash(int k, int bandas, int filas) {
+    IndiceMinHash indice(k, bandas, filas);
+    vector<int> ids, posicion;
+    secuenciasDistintas(ids, posicion);
+    vector<VistaEmpaquetada> vistas;
+    for (int id : ids) vistas.push_back(secuencias.vista(id));
+    indice.anadirEnBloque(vistas, posicion);
+    return indice;
+}
+vector<int> ListaCadenasADN::mutacionesContra(const CadenaADN& c, int umbral) {
+    vector<int> ids, posicion;
+    secuenciasDistintas(ids, posicion);
+    VistaEmpaquetada v = c.getSecuenciaEmpaquetada().vista();
+    vector<int> distintas(ids.size());
+    paraleloPorBloques(ids.size(), GRANO_PARALELO, [&](size_t ini, size_t fin) {
+        for (size_t k = ini; k < fin; k++) distintas[k] = distanciaMutaciones(v, secuencias.vista(ids[k]), umbral);
+    });
+    vector<int> res(posicion.size());
+    for (size_t a = 0; a < posicion.size(); a++) res[a] = distintas[posicion[a]];
+    return res;
+}
+
+int ListaCadenasADN::cargarFASTA(const string& path, vector<ErrorLectura>& errores) {
+    LectorFASTA lector;
+    if (!lector.abrir(path)) return -1;
+    RegistroFASTA r;
+    int cargados = 0;
+    SesionCarga sesion(*this);
+    while (lector.siguiente(r)) { insertarFinal(CadenaADN(SecuenciaEmpaquetada(r.secuencia), r.descripcion)); cargados++; }
+    errores = lector.getErrores();
+    return cargados;
+}
+
+bool ListaCadenasADN::guardarInstantanea(const string& path) { return InstantaneaADN::guardar(*this, path); }
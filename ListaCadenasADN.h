@@ -2,20 +2,49 @@
 #define LISTACADENASADN_H
 
 #include "CadenaADN.h"
+#include "BuscadorMultiple.h"
+#include "PoolSecuencias.h"
+#include "LectorFASTA.h"
+#include "CuerdaADN.h"
+#include "ContadorKmers.h"
+#include "IndiceMinHash.h"
+#include "Paralelo.h"
 #include <string>
-#include <list>
 #include <map>
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <utility>
 
 using namespace std;
 
 class ListaCadenasADN;
+class InstantaneaADN;
+
+// Registro de la lista visto sin copiarlo: la secuencia se lee del pool y la
+// descripción del almacén de la lista. Es válido mientras la lista no cambie.
+class RegistroLista {
+    friend class ListaCadenasADN;
+    friend class IteradorLista;
+   private:
+    const ListaCadenasADN* lista;
+    int registro;
+    RegistroLista(const ListaCadenasADN*, int);
+
+   public:
+    VistaEmpaquetada vista() const;
+    string getSecuencia() const;
+    string getDescripcion() const;
+    int getLongitud() const;
+    CadenaADN cadena() const; // Copia como CadenaADN independiente
+    const RegistroLista* operator->() const { return this; }
+};
 
 class IteradorLista {
     friend class ListaCadenasADN;
    private:
-    list<CadenaADN>::iterator iter;
+    const ListaCadenasADN* lista;
+    int registro; // Manejador estable del registro (0 es el centinela: end/rend)
     bool vacio; // Para controlar el estado del constructor por defecto
 
    public:
@@ -28,24 +57,79 @@ class IteradorLista {
     bool operator==(const IteradorLista&) const;
     bool operator!=(const IteradorLista&) const;
     bool esVacio() const; // Requerido por el enunciado [cite: 152, 236]
+    // Acceso sin copia al elemento (el iterador no puede ser vacío ni end()).
+    // Es de solo lectura: los cambios se hacen con asignar para mantener los índices.
+    RegistroLista operator*() const;
+    RegistroLista operator->() const;
 };
 
 class ListaCadenasADN {
+    friend class InstantaneaADN;
+    friend class SesionCarga;
+    friend class RegistroLista;
+    friend class IteradorLista;
 private:
-    list<CadenaADN> data; // Contenedor principal STL [cite: 6, 205]
-    
+    // Almacén de registros por columnas (estructura de arrays). Cada registro
+    // ocupa un hueco estable, su manejador, y el orden de la lista lo dan los
+    // enlaces siguiente/anterior (lista circular; el hueco 0 es el centinela).
+    // Insertar o borrar en cualquier punto es O(1) y no mueve otros registros.
+    vector<int> secuenciaRegistro;            // Identificador en el pool
+    vector<uint32_t> inicioDescripcion, longDescripcion;
+    vector<int> siguiente, anterior;
+    vector<int> huecosLibres;
+    int numRegistros;
+    // Las descripciones van seguidas en una arena; las de registros borrados
+    // se recuperan compactándola cuando ocupan más de la mitad
+    string descripciones;
+    size_t bytesMuertos;
+    static const size_t MIN_COMPACTAR = 4096;
+
     // Atributos para eficiencia O(1) o independiente [cite: 8, 172, 191]
-    unordered_map<string, int> frecSecuencias;
-    unordered_map<string, int> frecCodones;
-    map<string, bool> codonesUnicos;
-    map<string, map<string, bool>> mapaCodonSecuencias;
+    // Cada secuencia distinta se guarda una vez y recibe un identificador;
+    // sus referencias son su frecuencia en la lista
+    PoolSecuencias secuencias;
+    // Índices por codón (código 0..63): frecuencia total y conjunto ordenado
+    // de identificadores de las secuencias que lo contienen. Durante una
+    // carga en bloque no se mantienen: quedan pendientes y se reconstruyen
+    // de una vez (al cerrar la carga o en la primera consulta que los use).
+    mutable array<int, 64> frecCodones;
+    mutable array<vector<int>, 64> secuenciasConCodon;
+    mutable bool indicesPendientes;
+    int cargasAbiertas; // Sesiones de carga en curso
 
-    void actualizarEstructuras(const CadenaADN& cadena, int incremento);
+    int altaSecuencia(const VistaEmpaquetada& v, const Huella& h);
+    void bajaSecuencia(int id);
+    int enlazarRegistro(int antesDe, int id, const string& desc);
+    void desenlazarRegistro(int r);
+    int nuevoRegistro(int antesDe, const VistaEmpaquetada& v, const Huella& h, const string& desc);
+    int nuevoRegistro(int antesDe, const CadenaADN& cadena);
+    void quitarRegistro(int r);
+    // Recalcula en paralelo las frecuencias y listas por codón desde el pool
+    void reconstruirIndices() const;
+    void asegurarIndices() const;
+    void insertarBloque(const vector<const CadenaADN*>& cadenas);
+    void fijarDescripcion(int r, const string& desc);
+    void compactarDescripciones();
+    string descripcionDe(int r) const;
+    bool esPropio(const IteradorLista& it, bool admiteFin) const;
+    int buscarId(const CadenaADN& cadena) const;
+
+    static const size_t GRANO_PARALELO = 256; // Registros por bloque de trabajo
+    static const size_t TESELA_MATRIZ = 64;   // Secuencias por lado de cada bloque de la matriz
+    static int distanciaMutaciones(const VistaEmpaquetada& a, const VistaEmpaquetada& b, int umbral);
+    // Secuencias distintas en orden de primera aparición y, por registro, su posición entre ellas
+    void secuenciasDistintas(vector<int>& ids, vector<int>& posicion) const;
+    // Reducción sobre las secuencias distintas: acumular(parcial, vista, referencias)
+    template <class T, class A, class R> T reducirSecuencias(const T& neutro, A acumular, R combinar) const;
 
 public:
     ListaCadenasADN();
     ListaCadenasADN(const ListaCadenasADN&);
+    // El movimiento no reserva memoria; la lista origen queda vacía y solo
+    // debe destruirse o recibir una asignación
+    ListaCadenasADN(ListaCadenasADN&&) noexcept;
     ListaCadenasADN& operator=(const ListaCadenasADN &);
+    ListaCadenasADN& operator=(ListaCadenasADN &&) noexcept;
     ~ListaCadenasADN();
 
     IteradorLista begin();
@@ -60,6 +144,18 @@ public:
     bool insertar(IteradorLista, const CadenaADN&);
     bool insertarDespues(IteradorLista, const CadenaADN&); // Nuevo [cite: 118, 162]
     bool asignar(IteradorLista, const CadenaADN&);
+    // Añade al final todas las cadenas de [ini, fin) como una carga en bloque:
+    // las huellas se calculan en paralelo y los índices se construyen una vez
+    template <class It> void insertarRango(It ini, It fin) {
+        vector<const CadenaADN*> cadenas;
+        for (; ini != fin; ++ini) cadenas.push_back(&*ini);
+        insertarBloque(cadenas);
+    }
+    // Construye una CadenaADN con esos argumentos y la añade al final; como
+    // en insertarFinal, su secuencia se copia a la arena del pool
+    template <class... Args> void emplazarFinal(Args&&... args) {
+        insertarFinal(CadenaADN(std::forward<Args>(args)...));
+    }
     bool borrarPrimera();
     bool borrarUltima();
     bool borrar(IteradorLista &);
@@ -68,6 +164,9 @@ public:
     ListaCadenasADN concatenar(ListaCadenasADN &);
     ListaCadenasADN diferencia(ListaCadenasADN &);
     CadenaADN concatenar();
+    // Concatenación perezosa de todas las secuencias, en orden de lista, sin
+    // copiarlas: se lee del pool y es válida mientras la lista no cambie
+    CuerdaADN cuerda() const;
     string aCadena();
 
     // Métodos nuevos Práctica 3 [cite: 117]
@@ -77,6 +176,79 @@ public:
     string listaCadenasADN();
     string listaCadenasConCodon(const string&);
     void eliminaDuplicados();
+
+    // Búsqueda de muchos patrones a la vez, en paralelo sobre los registros.
+    // 'secuencia' en cada coincidencia es la posición del registro en la lista.
+    vector<CoincidenciaPatron> buscarPatrones(const BuscadorMultiple &);
+    // Búsqueda aproximada (distancia de edición <= maxErrores) en todos los
+    // registros, en paralelo: (posición del registro, posición final, distancia)
+    vector<CoincidenciaAproximada> buscarAproximada(const string &patron, int maxErrores);
+    // ORF de los seis marcos de todos los registros ('secuencia' es la
+    // posición del registro), en orden de lista. Cada secuencia distinta se
+    // analiza una vez, en paralelo, sin crear cadenas por codón.
+    vector<MarcoAbierto> buscarORFs(int minAminoacidos);
+
+    // Map/reduce en paralelo sobre los registros en orden de lista:
+    // mapa(RegistroLista) -> T y combinar(T, T) -> T, que debe ser asociativa.
+    // El resultado no depende del número de hilos (ver reducirPorBloques).
+    template <class T, class M, class R> T reducir(const T& neutro, M mapa, R combinar) const {
+        vector<int> registros;
+        for (int r = siguiente[0]; r != 0; r = siguiente[r]) registros.push_back(r);
+        return reducirPorBloques(registros.size(), GRANO_PARALELO, neutro, [&](size_t ini, size_t fin) {
+            T parcial = neutro;
+            for (size_t k = ini; k < fin; k++) parcial = combinar(parcial, mapa(RegistroLista(this, registros[k])));
+            return parcial;
+        }, combinar);
+    }
+    // Agregados en paralelo. Se calculan una vez por secuencia distinta y se
+    // ponderan por su frecuencia, así que los duplicados no cuestan más.
+    // distribucionGC: registros por intervalo de proporción GC ([0,1) en partes iguales; 1.0 va al último)
+    vector<int> distribucionGC(int intervalos);
+    int contarChargaff();                // Registros que cumplen Chargaff
+    int rachaMaxima();                   // Homopolímero más largo de toda la lista
+    // Uso global de codones en marco; se mantiene al modificar la lista, no se recalcula
+    array<int, 64> usoCodones();
+    // Distancias de Hamming (criterio de CadenaADN::contarMutaciones) entre
+    // todos los registros: matriz n x n por filas, en orden de lista. Vale -1
+    // si las longitudes difieren o, con umbral >= 0, si la distancia supera el
+    // umbral (se deja de comparar en cuanto lo supera). Se calcula una vez por
+    // par de secuencias distintas, por bloques cuadrados y en paralelo.
+    vector<int> matrizMutaciones(int umbral = -1);
+    // Distancias de 'c' a cada registro, en orden de lista (mismo criterio)
+    vector<int> mutacionesContra(const CadenaADN& c, int umbral = -1);
+    // Conteo de k-mers (k de 1 a 31) de todos los registros, canónicos por
+    // defecto. Cada secuencia distinta se recorre una vez y pesa su frecuencia.
+    ContadorKmers contarKmers(int k, bool canonicos = true);
+    vector<pair<string, uint64_t> > kmersFrecuentes(int k, size_t n, bool canonicos = true);
+    vector<uint64_t> histogramaKmers(int k, size_t maximo, bool canonicos = true);
+    // Índice MinHash con una entrada por registro ('registro' en los
+    // resultados es la posición en la lista); para buscar secuencias
+    // parecidas sin compararlas todas. No se actualiza si la lista cambia.
+    IndiceMinHash indiceMinHash(int k = 16, int bandas = 16, int filas = 4);
+
+    // Añade al final todos los registros válidos de un fichero FASTA/FASTQ,
+    // leído en streaming. Devuelve cuántos se añadieron (-1 si no se abre);
+    // los registros descartados quedan en 'errores'.
+    int cargarFASTA(const string &path, vector<ErrorLectura> &errores);
+
+    // Guarda la lista y sus índices en formato binario; se consulta sin
+    // reconstruir nada abriéndola con InstantaneaADN
+    bool guardarInstantanea(const string &path);
+};
+
+// Carga en bloque: mientras la sesión exista, las modificaciones de la lista
+// solo guardan los registros y las secuencias, y los índices por codón se
+// construyen una sola vez al confirmar o al destruir la sesión.
+class SesionCarga {
+   private:
+    ListaCadenasADN* lista;
+
+   public:
+    explicit SesionCarga(ListaCadenasADN&);
+    SesionCarga(const SesionCarga&) = delete;
+    SesionCarga& operator=(const SesionCarga&) = delete;
+    ~SesionCarga();
+    void confirmar(); // Cierra la sesión antes de destruirla
 };
 
 #endif
\ No newline at end of file
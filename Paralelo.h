@@ -0,0 +1,173 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Número de hilos de trabajo: GENOMA_HILOS si está definida, si no los
+// núcleos disponibles (al menos 1)
+inline unsigned numHilos() {
+    const char *entorno = getenv("GENOMA_HILOS");
+    if (entorno != nullptr && atoi(entorno) > 0) {
+        return atoi(entorno);
+    }
+    unsigned n = thread::hardware_concurrency();
+    return (n == 0) ? 1 : n;
+}
+
+// Trabajadores persistentes (numHilos() - 1, fijado en el primer uso) que
+// comparten una tarea con el hilo que la lanza. Se crean una sola vez y
+// esperan dormidos entre tareas, así que una llamada paralela no paga la
+// creación de hilos. Solo hay una tarea a la vez: una llamada anidada (desde
+// dentro de una tarea) o simultánea desde otro hilo devuelve false y el
+// llamante la ejecuta él solo.
+class PoolHilos {
+    private:
+    mutex m;
+    condition_variable hayTarea, tareaTerminada;
+    vector<thread> trabajadores;
+    const function<void()> *tarea = nullptr;
+    unsigned long long generacion = 0; // Tareas lanzadas
+    size_t activos = 0;                // Trabajadores con la tarea actual en curso
+    bool cerrando = false;
+    mutex enUso;
+
+    static bool &dentroDeTarea() {
+        static thread_local bool dentro = false;
+        return dentro;
+    }
+
+    void bucle() {
+        dentroDeTarea() = true;
+        unsigned long long vista = 0;
+        unique_lock<mutex> l(m);
+        while (true) {
+            hayTarea.wait(l, [&]() { return cerrando || generacion != vista; });
+            if (cerrando) {
+                return;
+            }
+            vista = generacion;
+            const function<void()> *t = tarea;
+            l.unlock();
+            (*t)();
+            l.lock();
+            if (--activos == 0) {
+                tareaTerminada.notify_one();
+            }
+        }
+    }
+
+    PoolHilos() {
+        for (unsigned h = 1; h < numHilos(); h++) {
+            trabajadores.emplace_back(&PoolHilos::bucle, this);
+        }
+    }
+
+    public:
+    ~PoolHilos() {
+        {
+            lock_guard<mutex> l(m);
+            cerrando = true;
+        }
+        hayTarea.notify_all();
+        for (thread &t : trabajadores) {
+            t.join();
+        }
+    }
+
+    static PoolHilos &instancia() {
+        static PoolHilos pool;
+        return pool;
+    }
+
+    // Ejecuta 'trabajo' en todos los trabajadores y en el hilo actual, y
+    // vuelve cuando todos han terminado
+    bool ejecutar(const function<void()> &trabajo) {
+        if (dentroDeTarea() || trabajadores.empty()) {
+            return false;
+        }
+        unique_lock<mutex> uso(enUso, try_to_lock);
+        if (!uso) {
+            return false;
+        }
+        dentroDeTarea() = true;
+        {
+            lock_guard<mutex> l(m);
+            tarea = &trabajo;
+            activos = trabajadores.size();
+            generacion++;
+        }
+        hayTarea.notify_all();
+        trabajo();
+        {
+            unique_lock<mutex> l(m);
+            tareaTerminada.wait(l, [&]() { return activos == 0; });
+        }
+        dentroDeTarea() = false;
+        return true;
+    }
+};
+
+// Ejecuta f(ini, fin) sobre bloques consecutivos de [0, n) de tamaño 'grano'
+// con los trabajadores de PoolHilos. Los hilos van tomando el siguiente
+// bloque libre, así que el reparto se equilibra solo aunque unos bloques
+// cuesten más que otros. f no debe escribir en datos compartidos salvo en
+// posiciones propias de su bloque.
+template <typename F>
+void paraleloPorBloques(size_t n, size_t grano, F f) {
+    if (grano == 0) {
+        grano = 1;
+    }
+    size_t bloques = (n + grano - 1) / grano;
+    unsigned hilos = (unsigned)min<size_t>(numHilos(), bloques);
+
+    if (hilos <= 1) {
+        for (size_t ini = 0; ini < n; ini += grano) {
+            f(ini, min(n, ini + grano));
+        }
+        return;
+    }
+
+    atomic<size_t> siguiente(0);
+    function<void()> trabajar = [&]() {
+        for (size_t b = siguiente++; b < bloques; b = siguiente++) {
+            f(b * grano, min(n, (b + 1) * grano));
+        }
+    };
+    if (!PoolHilos::instancia().ejecutar(trabajar)) {
+        trabajar();
+    }
+}
+
+// Map/reduce determinista: cada bloque de 'grano' elementos produce un
+// parcial con mapa(ini, fin) y los parciales se combinan en el orden de los
+// bloques. Como el reparto en bloques no depende de los hilos, el resultado
+// es el mismo con cualquier número de hilos (también en coma flotante).
+template <typename T, typename M, typename R>
+T reducirPorBloques(size_t n, size_t grano, const T &neutro, M mapa, R combinar) {
+    if (grano == 0) {
+        grano = 1;
+    }
+    size_t bloques = (n + grano - 1) / grano;
+    vector<T> parciales(bloques, neutro);
+    paraleloPorBloques(bloques, 1, [&](size_t ini, size_t fin) {
+        for (size_t b = ini; b < fin; b++) {
+            parciales[b] = mapa(b * grano, min(n, (b + 1) * grano));
+        }
+    });
+    T resultado = neutro;
+    for (const T &p : parciales) {
+        resultado = combinar(resultado, p);
+    }
+    return resultado;
+}
+
+#endif // PARALELO_H
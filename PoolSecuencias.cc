@@ -0,0 +1,128 @@
+#include "PoolSecuencias.h"
+using namespace std;
+
+PoolSecuencias::PoolSecuencias() {}
+
+int PoolSecuencias::buscar(const VistaEmpaquetada &v) const {
+    return buscar(v, v.huella());
+}
+
+// La huella localiza la entrada; la comparación de palabras descarta colisiones
+int PoolSecuencias::buscar(const VistaEmpaquetada &v, const Huella &h) const {
+    auto rango = porHuella.equal_range(h);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        if (vista(it->second).igual(v)) {
+            return it->second;
+        }
+    }
+    return -1;
+}
+
+int PoolSecuencias::adquirir(const VistaEmpaquetada &v, bool &nueva) {
+    return adquirir(v, v.huella(), nueva);
+}
+
+int PoolSecuencias::adquirir(const VistaEmpaquetada &v, const Huella &h, bool &nueva) {
+    int id = buscar(v, h);
+    nueva = (id < 0);
+    if (nueva) {
+        if (libres.empty()) {
+            id = entradas.size();
+            entradas.emplace_back();
+        } else {
+            id = libres.back();
+            libres.pop_back();
+        }
+        // La vista podría apuntar a la propia arena, que puede moverse al crecer
+        size_t numPalabras = v.numPalabras();
+        const uint64_t *origen = v.palabras;
+        vector<uint64_t> copia;
+        if (origen >= arena.data() && origen < arena.data() + arena.size()) {
+            copia.assign(origen, origen + numPalabras);
+            origen = copia.data();
+        }
+        entradas[id].inicio = arena.size();
+        entradas[id].n = v.longitud();
+        arena.insert(arena.end(), origen, origen + numPalabras);
+        entradas[id].huella = h;
+        porHuella.emplace(h, id);
+    }
+    entradas[id].referencias++;
+    return id;
+}
+
+bool PoolSecuencias::liberar(int id) {
+    Entrada &e = entradas[id];
+    if (--e.referencias > 0) {
+        return false;
+    }
+    auto rango = porHuella.equal_range(e.huella);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        if (it->second == id) {
+            porHuella.erase(it);
+            break;
+        }
+    }
+    e.referencias = 0;
+    palabrasMuertas += vista(id).numPalabras();
+    e.n = 0;
+    libres.push_back(id);
+    if (palabrasMuertas >= MIN_COMPACTAR && 2 * palabrasMuertas > arena.size()) {
+        compactar();
+    }
+    return true;
+}
+
+// Copia las secuencias vivas a una arena nueva; los identificadores no cambian
+void PoolSecuencias::compactar() {
+    vector<uint64_t> nueva;
+    nueva.reserve(arena.size() - palabrasMuertas);
+    for (Entrada &e : entradas) {
+        if (e.referencias == 0) {
+            continue;
+        }
+        size_t numPalabras = (e.n + VistaEmpaquetada::BASES_POR_PALABRA - 1) / VistaEmpaquetada::BASES_POR_PALABRA;
+        size_t inicio = nueva.size();
+        nueva.insert(nueva.end(), arena.begin() + e.inicio, arena.begin() + e.inicio + numPalabras);
+        e.inicio = inicio;
+    }
+    arena.swap(nueva);
+    palabrasMuertas = 0;
+}
+
+int PoolSecuencias::referencias(int id) const {
+    return entradas[id].referencias;
+}
+
+VistaEmpaquetada PoolSecuencias::vista(int id) const {
+    VistaEmpaquetada v;
+    v.palabras = arena.data() + entradas[id].inicio;
+    v.n = entradas[id].n;
+    return v;
+}
+
+void PoolSecuencias::fijarReferencias(int id, int refs) {
+    if (refs > 0 && entradas[id].referencias > 0) {
+        entradas[id].referencias = refs;
+    }
+}
+
+const Huella &PoolSecuencias::huella(int id) const {
+    return entradas[id].huella;
+}
+
+size_t PoolSecuencias::capacidad() const {
+    return entradas.size();
+}
+
+size_t PoolSecuencias::numSecuencias() const {
+    return entradas.size() - libres.size();
+}
+
+void PoolSecuencias::vaciar() {
+    entradas.clear();
+    libres.clear();
+    arena.clear();
+    palabrasMuertas = 0;
+    porHuella.clear();
+}
@@ -0,0 +1,57 @@
+#ifndef POOLSECUENCIAS_H
+#define POOLSECUENCIAS_H
+
+#include <unordered_map>
+#include <vector>
+#include "SecuenciaEmpaquetada.h"
+
+using namespace std;
+
+// Almacén de secuencias internadas: cada secuencia distinta se guarda una
+// sola vez (empaquetada) y recibe un identificador estable mientras tenga
+// referencias. La búsqueda se hace por huella de 128 bits, sin comparar
+// cadenas salvo para confirmar la coincidencia.
+// Las palabras de todas las secuencias van seguidas en un único bloque
+// (arena); las de las secuencias liberadas se recuperan compactándolo cuando
+// ocupan más de la mitad.
+class PoolSecuencias {
+    private:
+    struct Entrada {
+        size_t inicio = 0;       // Primera palabra en la arena
+        size_t n = 0;            // Número de bases
+        Huella huella;
+        int referencias = 0;
+    };
+    vector<Entrada> entradas;
+    vector<int> libres;
+    vector<uint64_t> arena;
+    size_t palabrasMuertas = 0;
+    unordered_multimap<Huella, int, HashHuella> porHuella;
+
+    static const size_t MIN_COMPACTAR = 4096; // Palabras muertas antes de compactar
+    void compactar();
+    public:
+    PoolSecuencias();
+
+    // Identificador de la secuencia, o -1 si no está
+    int buscar(const VistaEmpaquetada &) const;
+    int buscar(const VistaEmpaquetada &, const Huella &) const;
+    // Añade una referencia (internando la secuencia si es nueva)
+    int adquirir(const VistaEmpaquetada &, bool &nueva);
+    int adquirir(const VistaEmpaquetada &, const Huella &, bool &nueva);
+    // Quita una referencia; devuelve true si la secuencia deja de estar
+    bool liberar(int id);
+
+    int referencias(int id) const;
+    // Cambia las referencias de una secuencia presente (para operaciones en bloque)
+    void fijarReferencias(int id, int referencias);
+    // Apunta a la arena: válida hasta la siguiente llamada a adquirir o liberar
+    VistaEmpaquetada vista(int id) const;
+    const Huella &huella(int id) const;
+    // Los identificadores válidos están en [0, capacidad())
+    size_t capacidad() const;
+    size_t numSecuencias() const;
+    void vaciar();
+};
+
+#endif // POOLSECUENCIAS_H
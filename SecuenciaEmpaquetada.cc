@@ -0,0 +1,651 @@
+#include "SecuenciaEmpaquetada.h"
+#include <algorithm>
+
+// Núcleos vectoriales: AVX2 si se compila con -mavx2, SSE2 en cualquier x86-64.
+// Definir GENOMA_SIN_SIMD fuerza la versión escalar.
+#if defined(__AVX2__) && !defined(GENOMA_SIN_SIMD)
+#define GENOMA_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) && !defined(GENOMA_SIN_SIMD)
+#define GENOMA_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// Bit bajo de cada base de una palabra
+static const uint64_t BITS_BAJOS = 0x5555555555555555ULL;
+
+// Popcount de cada byte, sumado en los cuatro (o dos) enteros de 64 bits
+#if defined(GENOMA_AVX2)
+// Tabla de nibbles (vpshufb) y suma con vpsadbw
+static inline __m256i popcount8(__m256i v) {
+    const __m256i tabla = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, nibble);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i c = _mm256_add_epi8(_mm256_shuffle_epi8(tabla, lo), _mm256_shuffle_epi8(tabla, hi));
+    return _mm256_sad_epu8(c, _mm256_setzero_si256());
+}
+
+static inline uint64_t sumar(__m256i v) {
+    uint64_t t[4];
+    _mm256_storeu_si256((__m256i *)t, v);
+    return t[0] + t[1] + t[2] + t[3];
+}
+#elif defined(GENOMA_SSE2)
+// SWAR por bytes dentro de registros de 128 bits y suma con psadbw
+static inline __m128i popcount8(__m128i v) {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+    v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+    v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+    return _mm_sad_epu8(v, _mm_setzero_si128());
+}
+
+static inline uint64_t sumar(__m128i v) {
+    uint64_t t[2];
+    _mm_storeu_si128((__m128i *)t, v);
+    return t[0] + t[1];
+}
+#endif
+
+// =============================================
+// NÚCLEO DE COMPOSICIÓN
+// =============================================
+
+// Suma, para las palabras [0, np), los popcount de los bits bajos, de los
+// bits altos y de los bits de bases con ambos bits a 1 (es decir, T).
+// Los bits sobrantes de la última palabra son cero y no cuentan.
+static void contarBitsBase(const uint64_t *p, size_t np,
+                           uint64_t &bajos, uint64_t &altos, uint64_t &ambos) {
+    size_t w = 0;
+    bajos = altos = ambos = 0;
+
+#if defined(GENOMA_AVX2)
+    const __m256i mbajos = _mm256_set1_epi64x((long long)BITS_BAJOS);
+    __m256i accBajos = _mm256_setzero_si256(), accAltos = accBajos, accAmbos = accBajos;
+
+    for (; w + 4 <= np; w += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + w));
+        __m256i b = _mm256_and_si256(v, mbajos);
+        __m256i a = _mm256_and_si256(_mm256_srli_epi64(v, 1), mbajos);
+        accBajos = _mm256_add_epi64(accBajos, popcount8(b));
+        accAltos = _mm256_add_epi64(accAltos, popcount8(a));
+        accAmbos = _mm256_add_epi64(accAmbos, popcount8(_mm256_and_si256(a, b)));
+    }
+    bajos = sumar(accBajos);
+    altos = sumar(accAltos);
+    ambos = sumar(accAmbos);
+#elif defined(GENOMA_SSE2)
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    __m128i accBajos = _mm_setzero_si128(), accAltos = accBajos, accAmbos = accBajos;
+
+    for (; w + 2 <= np; w += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + w));
+        __m128i b = _mm_and_si128(v, m1);
+        __m128i a = _mm_and_si128(_mm_srli_epi64(v, 1), m1);
+        accBajos = _mm_add_epi64(accBajos, popcount8(b));
+        accAltos = _mm_add_epi64(accAltos, popcount8(a));
+        accAmbos = _mm_add_epi64(accAmbos, popcount8(_mm_and_si128(a, b)));
+    }
+    bajos = sumar(accBajos);
+    altos = sumar(accAltos);
+    ambos = sumar(accAmbos);
+#endif
+
+    // Resto escalar (o todo, si no hay SIMD)
+    for (; w < np; w++) {
+        uint64_t b = p[w] & BITS_BAJOS;
+        uint64_t a = (p[w] >> 1) & BITS_BAJOS;
+        bajos += __builtin_popcountll(b);
+        altos += __builtin_popcountll(a);
+        ambos += __builtin_popcountll(a & b);
+    }
+}
+
+// =============================================
+// NÚCLEO DE HAMMING
+// =============================================
+
+// Bases distintas entre las palabras [0, np) de p y q: una base difiere si
+// alguno de sus dos bits difiere, así que se pliega el XOR sobre el bit bajo
+static size_t contarDiferencias(const uint64_t *p, const uint64_t *q, size_t np) {
+    size_t w = 0;
+    uint64_t total = 0;
+
+#if defined(GENOMA_AVX2)
+    const __m256i mbajos = _mm256_set1_epi64x((long long)BITS_BAJOS);
+    __m256i acc = _mm256_setzero_si256();
+    for (; w + 4 <= np; w += 4) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p + w)),
+                                     _mm256_loadu_si256((const __m256i *)(q + w)));
+        x = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 1)), mbajos);
+        acc = _mm256_add_epi64(acc, popcount8(x));
+    }
+    total = sumar(acc);
+#elif defined(GENOMA_SSE2)
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    __m128i acc = _mm_setzero_si128();
+    for (; w + 2 <= np; w += 2) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + w)),
+                                  _mm_loadu_si128((const __m128i *)(q + w)));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_srli_epi64(x, 1)), m1);
+        acc = _mm_add_epi64(acc, popcount8(x));
+    }
+    total = sumar(acc);
+#endif
+
+    for (; w < np; w++) {
+        uint64_t x = p[w] ^ q[w];
+        total += __builtin_popcountll((x | (x >> 1)) & BITS_BAJOS);
+    }
+    return total;
+}
+
+// =============================================
+// VISTA EMPAQUETADA
+// =============================================
+
+char VistaEmpaquetada::base(size_t i) const {
+    return SecuenciaEmpaquetada::decodificarBase(codigo(i));
+}
+
+uint64_t VistaEmpaquetada::basesDesde(size_t inicio) const {
+    size_t w = inicio >> 5;
+    int desp = (inicio & 31) * 2;
+    uint64_t x = palabras[w] >> desp;
+    if (desp != 0 && w + 1 < numPalabras()) {
+        x |= palabras[w + 1] << (64 - desp);
+    }
+    return x;
+}
+
+uint64_t VistaEmpaquetada::mascaraUltima() const {
+    size_t resto = n % BASES_POR_PALABRA;
+    return (resto == 0) ? ~0ULL : ((1ULL << (2 * resto)) - 1);
+}
+
+// Los 6 bits del codón están en el orden de empaquetado (primera base en
+// los bits bajos); se reordenan para que la primera base quede arriba
+int VistaEmpaquetada::codon(size_t k) const {
+    size_t bit = 6 * k;
+    size_t w = bit >> 6;
+    size_t desp = bit & 63;
+    uint64_t bruto = palabras[w] >> desp;
+    if (desp > 58) {
+        bruto |= palabras[w + 1] << (64 - desp);
+    }
+    return (int)(((bruto & 3) << 4) | (bruto & 0xc) | ((bruto >> 4) & 3));
+}
+
+string VistaEmpaquetada::decodificar() const {
+    string s(n, 'A');
+    for (size_t i = 0; i < n; i++) {
+        s[i] = base(i);
+    }
+    return s;
+}
+
+// Compara palabra a palabra (los bits sobrantes siempre son cero)
+bool VistaEmpaquetada::igual(const VistaEmpaquetada &otra) const {
+    if (n != otra.n) {
+        return false;
+    }
+    for (size_t w = 0; w < numPalabras(); w++) {
+        if (palabras[w] != otra.palabras[w]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mezcla final de MurmurHash3 (biyectiva, buena avalancha)
+static inline uint64_t mezclar(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Dos acumuladores con constantes y rotaciones distintas sobre las palabras
+Huella VistaEmpaquetada::huella() const {
+    uint64_t h1 = 0x9e3779b97f4a7c15ULL ^ n;
+    uint64_t h2 = 0xc2b2ae3d27d4eb4fULL + n;
+    for (size_t w = 0; w < numPalabras(); w++) {
+        uint64_t k = palabras[w];
+        h1 = (h1 ^ mezclar(k + 0x87c37b91114253d5ULL)) * 0x4cf5ad432745937fULL;
+        h1 = (h1 << 27) | (h1 >> 37);
+        h2 = (h2 + mezclar(k ^ 0x52dce729da3ed7b5ULL)) * 0x9fb21c651e98df25ULL;
+        h2 = (h2 << 31) | (h2 >> 33);
+    }
+    Huella h;
+    h.alta = mezclar(h1 + h2);
+    h.baja = mezclar(h2 ^ (h1 >> 1));
+    return h;
+}
+
+// Cuenta las apariciones de una base comparando 32 bases por palabra
+size_t VistaEmpaquetada::contarBase(int cod) const {
+    const uint64_t patron = BITS_BAJOS * (uint64_t)cod;
+    size_t total = 0;
+    size_t np = numPalabras();
+
+    for (size_t w = 0; w < np; w++) {
+        uint64_t x = palabras[w] ^ patron;
+        uint64_t iguales = ~(x | (x >> 1)) & BITS_BAJOS;
+        if (w + 1 == np) {
+            iguales &= mascaraUltima();
+        }
+        total += __builtin_popcountll(iguales);
+    }
+    return total;
+}
+
+// C=01, G=10 y T=11: con tres popcount se obtienen las cuatro cuentas
+Composicion VistaEmpaquetada::composicion() const {
+    uint64_t bajos, altos, ambos;
+    contarBitsBase(palabras, numPalabras(), bajos, altos, ambos);
+
+    Composicion c;
+    c.cuentas[3] = ambos;
+    c.cuentas[2] = altos - ambos;
+    c.cuentas[1] = bajos - ambos;
+    c.cuentas[0] = n - c.cuentas[1] - c.cuentas[2] - c.cuentas[3];
+    return c;
+}
+
+// Llama a f(codigo, inicio, longitud) por cada racha de [ini, fin), en orden
+// (las de los extremos se recortan al intervalo). Los cambios de base se
+// detectan de 32 en 32: XOR de cada palabra con ella misma desplazada una
+// base, y solo se visitan los bits de los cambios, no todas las bases.
+template <typename F>
+static void recorrerRachas(const VistaEmpaquetada &v, size_t ini, size_t fin, F f) {
+    if (ini >= fin) {
+        return;
+    }
+    size_t inicio = ini;
+    for (size_t w = ini >> 5; w <= (fin - 1) >> 5; w++) {
+        uint64_t palabra = v.palabras[w];
+        uint64_t previa = (w > 0) ? (v.palabras[w - 1] >> 62) : (palabra & 3);
+        uint64_t x = palabra ^ ((palabra << 2) | previa);
+        uint64_t cambios = (x | (x >> 1)) & BITS_BAJOS; // Bit 2j: la base j difiere de la anterior
+        if (w == (ini >> 5)) {
+            cambios &= ~0ULL << (2 * (ini & 31) + 1);
+        }
+        if (w == ((fin - 1) >> 5) && (fin & 31) != 0) {
+            cambios &= (1ULL << (2 * (fin & 31))) - 1;
+        }
+        while (cambios != 0) {
+            size_t pos = (w << 5) + (__builtin_ctzll(cambios) >> 1);
+            f(v.codigo(inicio), inicio, pos - inicio);
+            inicio = pos;
+            cambios &= cambios - 1;
+        }
+    }
+    f(v.codigo(inicio), inicio, fin - inicio);
+}
+
+void VistaEmpaquetada::rachasMaximas(int maxima[4]) const {
+    maxima[0] = maxima[1] = maxima[2] = maxima[3] = 0;
+    recorrerRachas(*this, 0, n, [&](int cod, size_t, size_t longitud) {
+        if ((int)longitud > maxima[cod]) {
+            maxima[cod] = longitud;
+        }
+    });
+}
+
+vector<Racha> VistaEmpaquetada::rachas(size_t minimo, size_t ini, size_t fin) const {
+    vector<Racha> resultado;
+    recorrerRachas(*this, ini, min(fin, n), [&](int cod, size_t inicio, size_t longitud) {
+        if (longitud >= minimo) {
+            Racha r;
+            r.inicio = inicio;
+            r.longitud = longitud;
+            r.codigo = cod;
+            resultado.push_back(r);
+        }
+    });
+    return resultado;
+}
+
+// Número de posiciones distintas: XOR + popcount por palabra
+size_t VistaEmpaquetada::distanciaHamming(const VistaEmpaquetada &otra) const {
+    return contarDiferencias(palabras, otra.palabras, numPalabras());
+}
+
+// Se compara por tramos y se para en cuanto el total supera el límite
+size_t VistaEmpaquetada::distanciaHammingAcotada(const VistaEmpaquetada &otra, size_t limite) const {
+    static const size_t TRAMO = 64; // Palabras (2048 bases) entre comprobaciones
+    size_t total = 0, np = numPalabras();
+    for (size_t w = 0; w < np && total <= limite; w += TRAMO) {
+        total += contarDiferencias(palabras + w, otra.palabras + w, min(TRAMO, np - w));
+    }
+    return total;
+}
+
+// Dos secuencias son complementarias si su XOR tiene todos los bits a 1.
+// Se comprueban bloques de palabras y se sale en el primero que no lo cumpla.
+bool VistaEmpaquetada::esComplementaria(const VistaEmpaquetada &otra) const {
+    size_t np = numPalabras();
+    if (np == 0) {
+        return true;
+    }
+    size_t w = 0;
+    const uint64_t *p = palabras, *q = otra.palabras;
+
+#if defined(GENOMA_AVX2)
+    const __m256i unos = _mm256_set1_epi64x(-1);
+    for (; w + 4 < np; w += 4) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(p + w)),
+                                     _mm256_loadu_si256((const __m256i *)(q + w)));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(x, unos)) != -1) {
+            return false;
+        }
+    }
+#elif defined(GENOMA_SSE2)
+    const __m128i unos = _mm_set1_epi32(-1);
+    for (; w + 2 < np; w += 2) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + w)),
+                                  _mm_loadu_si128((const __m128i *)(q + w)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, unos)) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+
+    // La última palabra siempre va por aquí: sus bits sobrantes son cero
+    for (; w < np; w++) {
+        uint64_t esperado = (w + 1 == np) ? mascaraUltima() : ~0ULL;
+        if ((p[w] ^ q[w]) != esperado) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================
+// COMPLEMENTARIO INVERSO
+// =============================================
+
+// Invierte el orden de las 32 bases de una palabra: se intercambian pares
+// de bits, luego nibbles, y el resto lo hace el intercambio de bytes
+static inline uint64_t invertirBases(uint64_t x) {
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(x);
+}
+
+// 32 bases de la vista a partir de 'inicio', que puede ser negativo (hasta
+// -31): las posiciones fuera de la secuencia quedan a cero
+static inline uint64_t extraerBases(const VistaEmpaquetada &v, long long inicio) {
+    if (inicio < 0) {
+        return v.palabras[0] << (2 * -inicio);
+    }
+    return v.basesDesde(inicio);
+}
+
+// Palabra k del complementario inverso de la vista: sus bases son las
+// complementarias de n-1-32k, n-2-32k, ...
+static inline uint64_t palabraComplementoInverso(const VistaEmpaquetada &v, size_t k) {
+    long long fin = (long long)v.n - 32 * (long long)k; // Exclusivo
+    uint64_t x = ~invertirBases(extraerBases(v, fin - 32));
+    size_t cuantas = min<long long>(32, fin);
+    return (cuantas == 32) ? x : (x & ((1ULL << (2 * cuantas)) - 1));
+}
+
+void VistaEmpaquetada::complementoInverso(uint64_t *destino) const {
+    for (size_t k = 0; k < numPalabras(); k++) {
+        destino[k] = palabraComplementoInverso(*this, k);
+    }
+}
+
+// Se genera cada palabra del complementario inverso de la otra y se compara
+// con la propia, así que se sale en la primera que no coincida
+bool VistaEmpaquetada::esComplementariaInversa(const VistaEmpaquetada &otra) const {
+    for (size_t k = 0; k < numPalabras(); k++) {
+        if (palabras[k] != palabraComplementoInverso(otra, k)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// La ventana [p, p+m) es palíndromo si coincide con su complementario
+// inverso, es decir, con las bases [n-p-m, n-p) del complementario inverso
+// de toda la secuencia, que se calcula una vez. Se compara de 32 en 32.
+vector<size_t> VistaEmpaquetada::sitiosPalindromicos(size_t m) const {
+    vector<size_t> sitios;
+    if (m == 0 || m % 2 != 0 || m > n) {
+        return sitios;
+    }
+    vector<uint64_t> inverso(numPalabras());
+    complementoInverso(inverso.data());
+    VistaEmpaquetada vi;
+    vi.palabras = inverso.data();
+    vi.n = n;
+
+    for (size_t p = 0; p + m <= n; p++) {
+        size_t j = n - p - m;
+        bool igual = true;
+        for (size_t k = 0; k < m && igual; k += 32) {
+            uint64_t diferencia = extraerBases(*this, p + k) ^ extraerBases(vi, j + k);
+            if (m - k < 32) {
+                diferencia &= (1ULL << (2 * (m - k))) - 1;
+            }
+            igual = (diferencia == 0);
+        }
+        if (igual) {
+            sitios.push_back(p);
+        }
+    }
+    return sitios;
+}
+
+// =============================================
+// CODIFICACIÓN
+// =============================================
+
+// Un byte es válido si coincide con alguna de las cuatro bases; la máscara de
+// bytes no válidos de cada bloque da directamente la posición del primero
+long long SecuenciaEmpaquetada::primeraNoValida(const char *p, size_t n) {
+    size_t i = 0;
+
+#if defined(GENOMA_AVX2)
+    const __m256i a = _mm256_set1_epi8('A'), c = _mm256_set1_epi8('C');
+    const __m256i g = _mm256_set1_epi8('G'), t = _mm256_set1_epi8('T');
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i ok = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, a), _mm256_cmpeq_epi8(v, c)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, g), _mm256_cmpeq_epi8(v, t)));
+        uint32_t malos = ~(uint32_t)_mm256_movemask_epi8(ok);
+        if (malos != 0) {
+            return i + __builtin_ctz(malos);
+        }
+    }
+#elif defined(GENOMA_SSE2)
+    const __m128i a = _mm_set1_epi8('A'), c = _mm_set1_epi8('C');
+    const __m128i g = _mm_set1_epi8('G'), t = _mm_set1_epi8('T');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i ok = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, a), _mm_cmpeq_epi8(v, c)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, g), _mm_cmpeq_epi8(v, t)));
+        uint32_t malos = ~(uint32_t)_mm_movemask_epi8(ok) & 0xffff;
+        if (malos != 0) {
+            return i + __builtin_ctz(malos);
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (codificar(p[i]) < 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int SecuenciaEmpaquetada::codificar(char c) {
+    switch (c) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default:  return -1;
+    }
+}
+
+char SecuenciaEmpaquetada::decodificarBase(int cod) {
+    static const char BASES[4] = {'A', 'C', 'G', 'T'};
+    return BASES[cod & 3];
+}
+
+int SecuenciaEmpaquetada::codificarCodon(const string &codon) {
+    if (codon.length() != 3) {
+        return -1;
+    }
+    int valor = 0;
+    for (char c : codon) {
+        int cod = codificar(c);
+        if (cod < 0) {
+            return -1;
+        }
+        valor = (valor << 2) | cod;
+    }
+    return valor;
+}
+
+// Las 64 cadenas se crean una sola vez
+const string &SecuenciaEmpaquetada::decodificarCodon(int codon) {
+    static const vector<string> tabla = [] {
+        vector<string> t(64);
+        for (int c = 0; c < 64; c++) {
+            t[c] = {decodificarBase(c >> 4), decodificarBase(c >> 2), decodificarBase(c)};
+        }
+        return t;
+    }();
+    return tabla[codon & 63];
+}
+
+// =============================================
+// SECUENCIA EMPAQUETADA
+// =============================================
+
+SecuenciaEmpaquetada::SecuenciaEmpaquetada() {}
+
+SecuenciaEmpaquetada::SecuenciaEmpaquetada(const string &sec) {
+    asignar(sec);
+}
+
+// Copia las palabras de una vista (de otra secuencia o de un buffer externo)
+SecuenciaEmpaquetada::SecuenciaEmpaquetada(const VistaEmpaquetada &v)
+    : palabras(v.palabras, v.palabras + v.numPalabras()), n(v.longitud()) {
+    // Los bits sobrantes deben ser cero (igual, huella y los núcleos lo
+    // suponen) aunque la vista venga de un buffer externo
+    if (!palabras.empty()) {
+        palabras.back() &= v.mascaraUltima();
+    }
+}
+
+SecuenciaEmpaquetada::SecuenciaEmpaquetada(SecuenciaEmpaquetada &&otra) noexcept
+    : palabras(std::move(otra.palabras)), n(otra.n) {
+    otra.palabras.clear();
+    otra.n = 0;
+}
+
+SecuenciaEmpaquetada &SecuenciaEmpaquetada::operator=(SecuenciaEmpaquetada &&otra) noexcept {
+    if (this != &otra) {
+        palabras = std::move(otra.palabras);
+        n = otra.n;
+        otra.palabras.clear();
+        otra.n = 0;
+    }
+    return *this;
+}
+
+// Empaqueta una secuencia ya validada
+void SecuenciaEmpaquetada::asignar(const string &sec) {
+    n = sec.length();
+    palabras.assign((n + VistaEmpaquetada::BASES_POR_PALABRA - 1) / VistaEmpaquetada::BASES_POR_PALABRA, 0);
+    for (size_t i = 0; i < n; i++) {
+        palabras[i >> 5] |= (uint64_t)(codificar(sec[i]) & 3) << ((i & 31) * 2);
+    }
+}
+
+string SecuenciaEmpaquetada::decodificar() const {
+    return vista().decodificar();
+}
+
+VistaEmpaquetada SecuenciaEmpaquetada::vista() const {
+    VistaEmpaquetada v;
+    v.palabras = palabras.data();
+    v.n = n;
+    return v;
+}
+
+void SecuenciaEmpaquetada::fijar(size_t i, int cod) {
+    int desp = (i & 31) * 2;
+    palabras[i >> 5] = (palabras[i >> 5] & ~(3ULL << desp)) | ((uint64_t)(cod & 3) << desp);
+}
+
+// Complementa todas las bases con un XOR por palabra
+void SecuenciaEmpaquetada::complementar() {
+    for (uint64_t &w : palabras) {
+        w = ~w;
+    }
+    if (!palabras.empty()) {
+        palabras.back() &= vista().mascaraUltima();
+    }
+}
+
+void SecuenciaEmpaquetada::reservar(size_t bases) {
+    palabras.reserve((bases + VistaEmpaquetada::BASES_POR_PALABRA - 1) / VistaEmpaquetada::BASES_POR_PALABRA);
+}
+
+// Si la nueva secuencia empieza a mitad de palabra, cada palabra de la vista
+// se reparte entre la palabra actual y la siguiente
+void SecuenciaEmpaquetada::anadir(const VistaEmpaquetada &v) {
+    if (v.longitud() == 0) {
+        return;
+    }
+    if (v.palabras >= palabras.data() && v.palabras < palabras.data() + palabras.size()) {
+        SecuenciaEmpaquetada copia(v); // La vista apunta a esta misma secuencia
+        anadir(copia.vista());
+        return;
+    }
+    int desp = (n & 31) * 2;
+    size_t total = n + v.longitud();
+    size_t palabrasTotal = (total + VistaEmpaquetada::BASES_POR_PALABRA - 1) / VistaEmpaquetada::BASES_POR_PALABRA;
+    size_t w = n >> 5;
+    palabras.resize(palabrasTotal, 0);
+    for (size_t k = 0; k < v.numPalabras(); k++) {
+        uint64_t palabra = v.palabras[k];
+        if (k + 1 == v.numPalabras()) {
+            palabra &= v.mascaraUltima();
+        }
+        palabras[w + k] |= palabra << desp;
+        if (desp != 0 && w + k + 1 < palabrasTotal) {
+            palabras[w + k + 1] |= palabra >> (64 - desp);
+        }
+    }
+    n = total;
+}
+
+void SecuenciaEmpaquetada::complementarInverso() {
+    vector<uint64_t> inverso(palabras.size());
+    vista().complementoInverso(inverso.data());
+    palabras.swap(inverso);
+}
+
+bool SecuenciaEmpaquetada::operator==(const SecuenciaEmpaquetada &otra) const {
+    return vista().igual(otra.vista());
+}
+
+bool SecuenciaEmpaquetada::operator!=(const SecuenciaEmpaquetada &otra) const {
+    return !(*this == otra);
+}
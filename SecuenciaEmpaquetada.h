@@ -0,0 +1,160 @@
+#ifndef SECUENCIAEMPAQUETADA_H
+#define SECUENCIAEMPAQUETADA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Codificación de 2 bits por base: A=00, C=01, G=10, T=11.
+// El orden de los códigos coincide con el alfabético y el complementario
+// de una base es su XOR con 11 (A<->T, C<->G).
+// La base i ocupa los bits 2*(i%32) y 2*(i%32)+1 de la palabra i/32.
+
+// Número de apariciones de cada base, indexado por código (A, C, G, T)
+struct Composicion {
+    size_t cuentas[4] = {0, 0, 0, 0};
+
+    size_t gc() const { return cuentas[1] + cuentas[2]; }
+    size_t total() const { return cuentas[0] + cuentas[1] + cuentas[2] + cuentas[3]; }
+};
+
+// Huella de 128 bits de una secuencia: dos resúmenes independientes de las
+// palabras empaquetadas y la longitud. Dos secuencias con la misma huella
+// son iguales salvo colisión (probabilidad despreciable, ~2^-128).
+struct Huella {
+    uint64_t alta = 0;
+    uint64_t baja = 0;
+
+    bool operator==(const Huella &o) const { return alta == o.alta && baja == o.baja; }
+    bool operator!=(const Huella &o) const { return !(*this == o); }
+};
+
+// Homopolímero: 'longitud' bases iguales (de código 'codigo') desde 'inicio'
+struct Racha {
+    size_t inicio = 0;
+    size_t longitud = 0;
+    int codigo = 0;
+
+    bool operator==(const Racha &o) const { return inicio == o.inicio && longitud == o.longitud && codigo == o.codigo; }
+};
+
+struct HashHuella {
+    size_t operator()(const Huella &h) const { return (size_t)h.baja; }
+};
+
+// Vista de solo lectura sobre un buffer de bases empaquetadas.
+// No posee la memoria: es válida mientras lo sea el buffer apuntado.
+struct VistaEmpaquetada {
+    const uint64_t *palabras = nullptr;
+    size_t n = 0; // Número de bases
+
+    static const int BASES_POR_PALABRA = 32;
+
+    size_t longitud() const { return n; }
+    size_t numPalabras() const { return (n + BASES_POR_PALABRA - 1) / BASES_POR_PALABRA; }
+    int codigo(size_t i) const { return (palabras[i >> 5] >> ((i & 31) * 2)) & 3; }
+    char base(size_t i) const;
+    // 32 bases a partir de 'inicio' (< longitud()); las que pasan del final valen 0
+    uint64_t basesDesde(size_t inicio) const;
+    // Máscara de los bits ocupados en la última palabra
+    uint64_t mascaraUltima() const;
+    // Codón k del marco 0 (bases 3k..3k+2) como entero de 6 bits
+    int codon(size_t k) const;
+
+    string decodificar() const;
+    bool igual(const VistaEmpaquetada &) const;
+    Huella huella() const;
+    size_t contarBase(int codigo) const;
+    // Cuenta las cuatro bases en una sola pasada
+    Composicion composicion() const;
+    // Homopolímero más largo de cada base (0 si no aparece)
+    void rachasMaximas(int maxima[4]) const;
+    // Rachas de al menos 'minimo' bases dentro de [ini, fin), en orden; las
+    // de los extremos se recortan al intervalo
+    vector<Racha> rachas(size_t minimo, size_t ini = 0, size_t fin = (size_t)-1) const;
+    // Requieren que ambas vistas tengan la misma longitud
+    size_t distanciaHamming(const VistaEmpaquetada &) const;
+    // Igual, pero deja de contar al superar 'limite': si la distancia es
+    // mayor, devuelve algún valor mayor que 'limite' (no necesariamente ella)
+    size_t distanciaHammingAcotada(const VistaEmpaquetada &, size_t limite) const;
+    bool esComplementaria(const VistaEmpaquetada &) const;
+    bool esComplementariaInversa(const VistaEmpaquetada &) const;
+    // Escribe en 'destino' (numPalabras() palabras) el complementario inverso
+    void complementoInverso(uint64_t *destino) const;
+    // Posiciones de las ventanas de m bases iguales a su complementario
+    // inverso (dianas palindrómicas como GAATTC); m debe ser par
+    vector<size_t> sitiosPalindromicos(size_t m) const;
+};
+
+// Codones en marco (sin solapar) de una vista, como enteros 0..63 con la
+// primera base en los bits altos: el orden numérico es el alfabético.
+// No crea cadenas ni reserva memoria.
+class VistaCodones {
+    private:
+    VistaEmpaquetada v;
+    public:
+    class iterador {
+        VistaEmpaquetada v;
+        size_t k;
+        public:
+        iterador(const VistaEmpaquetada &iv, size_t ik) : v(iv), k(ik) {}
+        int operator*() const { return v.codon(k); }
+        iterador &operator++() { k++; return *this; }
+        bool operator==(const iterador &o) const { return k == o.k; }
+        bool operator!=(const iterador &o) const { return k != o.k; }
+    };
+
+    explicit VistaCodones(const VistaEmpaquetada &iv) : v(iv) {}
+    size_t size() const { return v.longitud() / 3; }
+    int operator[](size_t k) const { return v.codon(k); }
+    iterador begin() const { return iterador(v, 0); }
+    iterador end() const { return iterador(v, size()); }
+};
+
+// Secuencia de nucleótidos almacenada con 2 bits por base.
+// Solo puede contener A, C, G o T: validar antes de asignar.
+class SecuenciaEmpaquetada {
+    private:
+    vector<uint64_t> palabras;
+    size_t n = 0;
+    public:
+    // Auxiliares de codificación
+    static int codificar(char);       // -1 si no es A, C, G o T
+    // Posición del primer carácter que no es A, C, G o T en [p, p + n), o -1
+    // si no hay ninguno; compara 16 o 32 caracteres por instrucción
+    static long long primeraNoValida(const char *p, size_t n);
+    static char decodificarBase(int);
+    static int codificarCodon(const string &);      // -1 si no es un codón válido
+    static const string &decodificarCodon(int);
+
+    SecuenciaEmpaquetada();
+    SecuenciaEmpaquetada(const string &);
+    explicit SecuenciaEmpaquetada(const VistaEmpaquetada &);
+    // El movimiento deja el origen vacío (longitud 0) y no reserva memoria
+    SecuenciaEmpaquetada(const SecuenciaEmpaquetada &) = default;
+    SecuenciaEmpaquetada(SecuenciaEmpaquetada &&) noexcept;
+    SecuenciaEmpaquetada &operator=(const SecuenciaEmpaquetada &) = default;
+    SecuenciaEmpaquetada &operator=(SecuenciaEmpaquetada &&) noexcept;
+
+    void asignar(const string &);
+    string decodificar() const;
+    VistaEmpaquetada vista() const;
+
+    size_t longitud() const { return n; }
+    int codigo(size_t i) const { return vista().codigo(i); }
+    char base(size_t i) const { return decodificarBase(codigo(i)); }
+    void fijar(size_t, int codigo);
+    void complementar();
+    void complementarInverso();
+    void reservar(size_t bases);
+    // Añade las bases de la vista al final, desplazando palabras enteras
+    void anadir(const VistaEmpaquetada &);
+
+    bool operator==(const SecuenciaEmpaquetada &) const;
+    bool operator!=(const SecuenciaEmpaquetada &) const;
+};
+
+#endif // SECUENCIAEMPAQUETADA_H